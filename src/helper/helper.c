@@ -0,0 +1,599 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+/*
+ * wihotspot-helper
+ *
+ * Privileged companion of the GUI. It is started once per session with
+ * pkexec, listens on a UNIX socket that only the invoking user can reach,
+ * and runs the few create_ap operations the GUI needs. This saves a polkit
+ * round trip for every status query or device list refresh.
+ *
+ * The helper exits when its stdin is closed, i.e. when the GUI goes away.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <grp.h>
+#include <limits.h>
+#include <poll.h>
+#include <pwd.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "helper_proto.h"
+#include "../ui/hostapd_ctrl.h"
+
+#define BUFSIZE 4096
+#define CONFIG_FILE_NAME "/etc/create_ap.conf"
+#define HOSTAPD_CONF_DIR "/etc/hostapd/"
+#define CREATE_AP_CONFDIR_PATTERN "/tmp/create_ap.*.conf.*"
+// hostapd does not hang up on its monitors, so check it is still there
+#define HOSTAPD_PING_MS 5000
+
+static char socket_path[108];
+static uid_t client_uid;
+static gid_t client_gid;
+
+static int write_all(int fd, const char *buf, size_t len){
+
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf += n;
+        len -= n;
+    }
+    return 0;
+}
+
+static void send_exit(int fd, int status, int at_line_start){
+
+    char buf[32];
+    int n = snprintf(buf, sizeof(buf), "%s%cEXIT %d\n", at_line_start ? "" : "\n", HELPER_EXIT_MARK, status);
+
+    write_all(fd, buf, n);
+}
+
+static void send_cancelled(int fd, int at_line_start){
+    dprintf(fd, "%s%c%s\n", at_line_start ? "" : "\n", HELPER_EXIT_MARK, HELPER_CANCELLED);
+}
+
+/**
+ * Wait for the child pid. Returns 0 with its wait status, or -1.
+ */
+static int wait_child(pid_t pid, int *status){
+
+    pid_t r;
+
+    while ((r = waitpid(pid, status, 0)) < 0 && errno == EINTR);
+
+    return r == pid ? 0 : -1;
+}
+
+/**
+ * Interrupt pid and its children like Ctrl+C, so create_ap still cleans
+ * up. Returns 0 if it had already exited, which is then reported as usual.
+ */
+static int interrupt_child(pid_t pid){
+
+    siginfo_t info;
+
+    memset(&info, 0, sizeof(info));
+    if (waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT) == 0 && info.si_pid == pid)
+        return 0;
+
+    return kill(-pid, SIGINT) == 0;
+}
+
+/**
+ * Read a request into buf. Returns the number of strings in req, or -1.
+ * *used receives the number of bytes consumed by the string list, so any
+ * payload starts at buf + *used.
+ */
+static int read_request(int fd, char *buf, size_t size, size_t *len, size_t *used, char **req, int max){
+
+    *len = 0;
+
+    for (;;) {
+        int nreq = 0;
+        size_t start = 0;
+
+        for (size_t i = 0; i < *len; i++) {
+            if (buf[i] != '\0')
+                continue;
+            if (i == start) {
+                *used = i + 1;
+                return nreq;
+            }
+            if (nreq == max)
+                return -1;
+            req[nreq++] = buf + start;
+            start = i + 1;
+        }
+
+        if (*len == size)
+            return -1;
+
+        ssize_t n = read(fd, buf + *len, size - *len);
+        if (n <= 0)
+            return -1;
+        *len += n;
+    }
+}
+
+/**
+ * Whether a component of path is "..", wherever it is.
+ */
+static int has_dot_dot(const char *path){
+
+    for (const char *p = path; *p != '\0'; p += strcspn(p, "/")) {
+        p += strspn(p, "/");
+        if (p[0] == '.' && p[1] == '.' && (p[2] == '/' || p[2] == '\0'))
+            return 1;
+    }
+    return 0;
+}
+
+/**
+ * Only fixed locations are written as root. Nothing read from a file the
+ * client can write itself decides this, that would let it name any file.
+ * A MAC filter file elsewhere is written as the user.
+ */
+static int allowed_as_root(const char *path){
+
+    return strcmp(path, CONFIG_FILE_NAME) == 0
+        || strncmp(path, HOSTAPD_CONF_DIR, strlen(HOSTAPD_CONF_DIR)) == 0;
+}
+
+static int copy_to(int out, int fd, size_t length, const char *data, size_t have){
+
+    char buf[BUFSIZE];
+
+    if (have > length)
+        have = length;
+    if (write_all(out, data, have) < 0)
+        return -1;
+    length -= have;
+
+    while (length > 0) {
+        ssize_t n = read(fd, buf, length < sizeof(buf) ? length : sizeof(buf));
+        if (n <= 0 || write_all(out, buf, n) < 0)
+            return -1;
+        length -= n;
+    }
+
+    return 0;
+}
+
+/**
+ * Write a file for the client. The system config and the files under
+ * HOSTAPD_CONF_DIR are written as root, anything else with the permissions
+ * of the invoking user. Relative paths and ".." are refused.
+ * The data goes to a temporary file that replaces path once it is synced,
+ * so readers never see a half written config. An existing file keeps its
+ * mode and owner.
+ */
+static int write_file(int fd, const char *path, size_t length, const char *data, size_t have){
+
+    pid_t pid;
+    int status;
+
+    if (path[0] != '/' || has_dot_dot(path))
+        return 2;
+
+    pid = fork();
+    if (pid < 0)
+        return -1;
+
+    if (pid == 0) {
+        char tmp[PATH_MAX];
+        struct stat st;
+        int out;
+
+        // root's supplementary groups would still open group writable places
+        if (!allowed_as_root(path)
+            && (setgroups(1, &client_gid) < 0 || setgid(client_gid) < 0 || setuid(client_uid) < 0))
+            _exit(1);
+
+        if (snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path) >= (int) sizeof(tmp))
+            _exit(1);
+
+        out = mkostemp(tmp, O_CLOEXEC);
+        if (out < 0)
+            _exit(1);
+
+        if (stat(path, &st) == 0) {
+            if (fchmod(out, st.st_mode & 07777) < 0 || (geteuid() == 0 && fchown(out, st.st_uid, st.st_gid) < 0))
+                goto fail;
+        } else if (fchmod(out, 0644) < 0) {
+            goto fail;
+        }
+
+        if (copy_to(out, fd, length, data, have) < 0 || fsync(out) < 0)
+            goto fail;
+
+        if (close(out) < 0 || rename(tmp, path) < 0) {
+            unlink(tmp);
+            _exit(1);
+        }
+        _exit(0);
+
+fail:
+        close(out);
+        unlink(tmp);
+        _exit(1);
+    }
+
+    if (wait_child(pid, &status) < 0)
+        return -1;
+
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/**
+ * Run create_ap and forward its output to the client. If the client goes
+ * away the output is still drained, so a running hotspot is not killed by
+ * a broken pipe. A cancel mark from the client interrupts it.
+ */
+static int run_create_ap(int fd, const char **argv){
+
+    char buf[BUFSIZE];
+    struct pollfd fds[2];
+    int pipefd[2];
+    int client_ok = 1;
+    int cancelled = 0;
+    int at_line_start = 1;
+    pid_t pid;
+    int status;
+    ssize_t n;
+
+    if (pipe(pipefd) < 0)
+        return -1;
+
+    pid = fork();
+    if (pid < 0)
+        return -1;
+
+    if (pid == 0) {
+        int null = open("/dev/null", O_RDONLY);
+        // Its own group, so a cancel reaches it like Ctrl+C would
+        setpgid(0, 0);
+        signal(SIGINT, SIG_DFL);
+        dup2(null, STDIN_FILENO);
+        dup2(pipefd[1], STDOUT_FILENO);
+        dup2(pipefd[1], STDERR_FILENO);
+        close(pipefd[0]);
+        close(pipefd[1]);
+        close(fd);
+        execvp(argv[0], (char *const *) argv);
+        _exit(127);
+    }
+
+    close(pipefd[1]);
+
+    fds[0].fd = pipefd[0];
+    fds[0].events = POLLIN;
+    fds[1].fd = fd;
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[1].revents) {
+            char c;
+
+            n = read(fd, &c, 1);
+            if (n == 1 && c == HELPER_CANCEL_MARK && !cancelled) {
+                cancelled = interrupt_child(pid);
+            } else if (n == 0 || (n < 0 && errno != EINTR)) {
+                // Gone, keep draining for the child
+                fds[1].fd = -1;
+                client_ok = 0;
+            }
+        }
+
+        if (fds[0].revents) {
+            n = read(pipefd[0], buf, sizeof(buf));
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                break;
+            if (client_ok && write_all(fd, buf, n) < 0)
+                client_ok = 0;
+            at_line_start = buf[n - 1] == '\n';
+        }
+    }
+
+    close(pipefd[0]);
+
+    if (wait_child(pid, &status) < 0)
+        status = -1;
+    else
+        status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    if (client_ok && cancelled)
+        send_cancelled(fd, at_line_start);
+    else if (client_ok)
+        send_exit(fd, status, at_line_start);
+
+    return status;
+}
+
+/**
+ * Whether path is the config directory of a create_ap instance. Those are
+ * made by root, so one of the client can not stand in for it.
+ */
+static int is_instance_confdir(const char *path){
+
+    struct stat st;
+
+    return fnmatch(CREATE_AP_CONFDIR_PATTERN, path, FNM_PATHNAME) == 0
+        && lstat(path, &st) == 0 && S_ISDIR(st.st_mode) && st.st_uid == 0;
+}
+
+/**
+ * Attach to the hostapd of an instance and forward its station events to
+ * the client until it cancels or goes away, or hostapd exits.
+ */
+static int relay_station_events(int fd, const char *confdir, const char *iface){
+
+    char msg[BUFSIZE];
+    struct pollfd fds[2];
+    HostapdCtrl *c;
+    HostapdEvent event;
+    int client_ok = 1;
+    int cancelled = 0;
+    ssize_t n;
+
+    if (!is_instance_confdir(confdir) || strchr(iface, '/') != NULL) {
+        dprintf(fd, "Not a create_ap config directory\n");
+        send_exit(fd, 2, 1);
+        return 2;
+    }
+
+    c = hostapd_ctrl_open(confdir, iface);
+    if (c == NULL) {
+        dprintf(fd, "Could not attach to hostapd: %s\n", strerror(errno));
+        send_exit(fd, 1, 1);
+        return 1;
+    }
+
+    fds[0].fd = hostapd_ctrl_fd(c);
+    fds[0].events = POLLIN;
+    fds[1].fd = fd;
+    fds[1].events = POLLIN;
+
+    while (client_ok && !cancelled) {
+        int r = poll(fds, 2, HOSTAPD_PING_MS);
+
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r < 0)
+            break;
+        // Refused once hostapd exited, its PONG is not an event
+        if (r == 0 && send(fds[0].fd, "PING", 4, 0) < 0)
+            break;
+
+        if (fds[1].revents) {
+            char ch;
+
+            n = read(fd, &ch, 1);
+            if (n == 1 && ch == HELPER_CANCEL_MARK)
+                cancelled = 1;
+            else if (n == 0 || (n < 0 && errno != EINTR))
+                client_ok = 0;
+        }
+
+        if (fds[0].revents) {
+            n = recv(fds[0].fd, msg, sizeof(msg) - 1, 0);
+            if (n < 0 && (errno == EINTR || errno == EAGAIN))
+                continue;
+            // hostapd exited
+            if (n < 0)
+                break;
+
+            // Only station events, which are one line each
+            if (hostapd_event_parse(msg, (size_t) n, &event) < 0)
+                continue;
+            msg[n] = '\0';
+            msg[strcspn(msg, "\n")] = '\0';
+            if (dprintf(fd, "%s\n", msg) < 0)
+                client_ok = 0;
+        }
+    }
+
+    hostapd_ctrl_close(c);
+
+    if (client_ok && cancelled)
+        send_cancelled(fd, 1);
+    else if (client_ok)
+        send_exit(fd, 1, 1);
+
+    return 1;
+}
+
+static void handle_client(int fd){
+
+    static char buf[HELPER_MAX_REQUEST];
+    char *req[HELPER_MAX_ARGS];
+    const char *argv[HELPER_MAX_ARGS + 4];
+    struct ucred cred;
+    socklen_t cred_len = sizeof(cred);
+    size_t len, used;
+    int nreq, argc;
+
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) < 0
+        || (cred.uid != client_uid && cred.uid != 0))
+        return;
+
+    nreq = read_request(fd, buf, sizeof(buf), &len, &used, req, HELPER_MAX_ARGS);
+    if (nreq < 0) {
+        send_exit(fd, 2, 1);
+        return;
+    }
+
+    argc = helper_build_argv(req, nreq, argv, HELPER_MAX_ARGS + 4);
+
+    if (argc < 0) {
+        dprintf(fd, "Unknown request\n");
+        send_exit(fd, 2, 1);
+    } else if (argc == 0 && strcmp(req[0], HELPER_STATION_EVENTS) == 0) {
+        relay_station_events(fd, req[1], req[2]);
+    } else if (argc == 0) {
+        char *end;
+        unsigned long length = strtoul(req[2], &end, 10);
+        int status = (*end != '\0') ? 2 : write_file(fd, req[1], length, buf + used, len - used);
+        send_exit(fd, status, 1);
+    } else {
+        run_create_ap(fd, argv);
+    }
+}
+
+static int open_socket(void){
+
+    struct sockaddr_un sa;
+    int fd;
+
+    if (mkdir(HELPER_SOCKET_DIR, 0755) < 0 && errno != EEXIST)
+        return -1;
+
+    if (helper_socket_path(socket_path, sizeof(socket_path), client_uid) < 0)
+        return -1;
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    strcpy(sa.sun_path, socket_path);
+
+    unlink(socket_path);
+    umask(0077);
+
+    if (bind(fd, (struct sockaddr *) &sa, sizeof(sa)) < 0
+        || chown(socket_path, client_uid, client_gid) < 0
+        || listen(fd, 16) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static void get_client_ids(void){
+
+    const char *uid = getenv("PKEXEC_UID");
+    struct passwd *pw;
+
+    client_uid = uid != NULL ? (uid_t) strtoul(uid, NULL, 10) : getuid();
+    client_gid = client_uid;
+
+    pw = getpwuid(client_uid);
+    if (pw != NULL)
+        client_gid = pw->pw_gid;
+}
+
+int main(int argc __attribute__((unused)), char *argv[]){
+
+    struct pollfd fds[2];
+    int listen_fd;
+
+    if (geteuid() != 0) {
+        fprintf(stderr, "%s must be run as root.\n", argv[0]);
+        return 1;
+    }
+
+    get_client_ids();
+
+    signal(SIGPIPE, SIG_IGN);
+    // Connection handlers are not waited for
+    signal(SIGCHLD, SIG_IGN);
+
+    listen_fd = open_socket();
+    if (listen_fd < 0) {
+        perror("Could not create helper socket");
+        return 1;
+    }
+
+    printf("%s\n", HELPER_READY);
+    fflush(stdout);
+
+    fds[0].fd = STDIN_FILENO;
+    fds[0].events = POLLIN;
+    fds[1].fd = listen_fd;
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[0].revents) {
+            char c;
+            // The GUI never writes, so readable stdin means it is gone
+            if (read(STDIN_FILENO, &c, 1) <= 0)
+                break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            int fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+            if (fd < 0)
+                continue;
+
+            if (fork() == 0) {
+                close(listen_fd);
+                signal(SIGCHLD, SIG_DFL);
+                handle_client(fd);
+                _exit(0);
+            }
+            close(fd);
+        }
+    }
+
+    unlink(socket_path);
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "helper_proto.h"
+
+#define CREATE_AP "create_ap"
+
+int helper_socket_path(char *buf, size_t size, uid_t uid){
+
+    int n = snprintf(buf, size, "%s/helper-%u.sock", HELPER_SOCKET_DIR, (unsigned int) uid);
+
+    return (n < 0 || (size_t) n >= size) ? -1 : 0;
+}
+
+/**
+ * Map a helper request to the create_ap command line it stands for.
+ * Only the verbs listed in helper_proto.h are accepted.
+ * Returns argc, 0 for requests that do not run create_ap, or -1.
+ */
+int helper_build_argv(char *const *req, int nreq, const char **argv, int max){
+
+    int argc = 0;
+
+    if (nreq < 1 || max < 8)
+        return -1;
+
+    argv[argc++] = CREATE_AP;
+
+    if (strcmp(req[0], HELPER_START) == 0 && (nreq == 2 || nreq == 3)) {
+        // the GUI shows where the time of the start went
+        argv[argc++] = "--trace";
+        argv[argc++] = "--config";
+        argv[argc++] = req[1];
+        if (nreq == 3) {
+            if (strcmp(req[2], "2.4") != 0 && strcmp(req[2], "5") != 0)
+                return -1;
+            argv[argc++] = "--freq-band";
+            argv[argc++] = req[2];
+        }
+    } else if (strcmp(req[0], HELPER_RELOAD) == 0 && (nreq == 3 || nreq == 4)) {
+        argv[argc++] = "--config";
+        argv[argc++] = req[1];
+        if (nreq == 4) {
+            if (strcmp(req[3], "2.4") != 0 && strcmp(req[3], "5") != 0)
+                return -1;
+            argv[argc++] = "--freq-band";
+            argv[argc++] = req[3];
+        }
+        argv[argc++] = "--reload";
+        argv[argc++] = req[2];
+    } else if (strcmp(req[0], HELPER_STOP) == 0 && nreq == 2) {
+        argv[argc++] = "--stop";
+        argv[argc++] = req[1];
+    } else if (strcmp(req[0], HELPER_LIST_RUNNING) == 0 && nreq == 1) {
+        argv[argc++] = "--list-running";
+    } else if (strcmp(req[0], HELPER_LIST_CLIENTS) == 0 && nreq == 2) {
+        argv[argc++] = "--list-clients";
+        argv[argc++] = req[1];
+    } else if ((strcmp(req[0], HELPER_WRITE_FILE) == 0 || strcmp(req[0], HELPER_STATION_EVENTS) == 0) && nreq == 3) {
+        return 0;
+    } else {
+        return -1;
+    }
+
+    argv[argc] = NULL;
+    return argc;
+}
@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_HELPER_PROTO_H
+#define WIHOTSPOT_HELPER_PROTO_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/*
+ * Wire format shared by wihotspot-helper and the GUI.
+ *
+ * A request is a list of NUL terminated strings closed by an empty string.
+ * The first one is the verb. "write-file" is followed by <length> raw bytes.
+ *
+ * The reply is the merged stdout/stderr of the command, line by line, and a
+ * last line "<HELPER_EXIT_MARK>EXIT <status>".
+ *
+ * Once the request is sent the client may write HELPER_CANCEL_MARK. If the
+ * command is still running it is interrupted and the last line is
+ * "<HELPER_EXIT_MARK>CANCELLED" instead. A client that only disconnects does
+ * not stop the command. write-file is never interrupted.
+ *
+ * "station-events" attaches to the hostapd of a running instance and
+ * replies with one line per station event, in hostapd's own format, until
+ * it is cancelled. hostapd's control socket stays root's, so the client
+ * can follow events without being able to send it commands.
+ */
+
+#define HELPER_BINARY "/usr/bin/wihotspot-helper"
+#define HELPER_SOCKET_DIR "/run/wihotspot"
+#define HELPER_READY "READY"
+#define HELPER_EXIT_MARK '\x1e'
+#define HELPER_CANCEL_MARK '\x18'
+#define HELPER_CANCELLED "CANCELLED"
+
+#define HELPER_START "start"                // start <config_file> [<freq_band>]
+#define HELPER_STOP "stop"                  // stop <pid|iface>
+#define HELPER_RELOAD "reload"              // reload <config_file> <pid|iface> [<freq_band>]
+#define HELPER_LIST_RUNNING "list-running"  // list-running
+#define HELPER_LIST_CLIENTS "list-clients"  // list-clients <pid|iface>
+#define HELPER_WRITE_FILE "write-file"      // write-file <path> <length>
+#define HELPER_STATION_EVENTS "station-events" // station-events <confdir> <iface>
+
+#define HELPER_MAX_ARGS 64
+#define HELPER_MAX_REQUEST 65536
+
+/* create_ap exit status when a reload needs the hotspot to be restarted */
+#define HELPER_RELOAD_NEEDS_RESTART 3
+
+int helper_socket_path(char *buf, size_t size, uid_t uid);
+int helper_build_argv(char *const *req, int nreq, const char **argv, int max);
+
+#endif //WIHOTSPOT_HELPER_PROTO_H
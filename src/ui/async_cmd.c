@@ -0,0 +1,456 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "async_cmd.h"
+#include "../helper/helper_proto.h"
+
+typedef enum {
+    HELPER_UNKNOWN,
+    HELPER_STARTING,
+    HELPER_RUNNING,
+    HELPER_UNAVAILABLE
+} HelperState;
+
+struct AsyncCmd {
+    gchar **req;
+    GBytes *payload;
+
+    AsyncCmdLineFunc on_line;
+    AsyncCmdDoneFunc on_done;
+    gpointer user_data;
+
+    GCancellable *cancellable;
+    guint timeout_id;
+    guint idle_id;
+    gint cancel_status;
+    gint status;
+    gboolean sent;              // the helper has the whole request
+
+    GSocketConnection *conn;    // helper
+    GSubprocess *proc;          // pkexec fallback
+    GDataInputStream *in;
+};
+
+static HelperState helper_state = HELPER_UNKNOWN;
+static GSubprocess *helper_proc;
+static GDataInputStream *helper_out;
+static GQueue pending = G_QUEUE_INIT;
+
+static void dispatch(AsyncCmd *cmd);
+
+static void finish(AsyncCmd *cmd, gint status){
+
+    if (cmd->timeout_id != 0)
+        g_source_remove(cmd->timeout_id);
+
+    if (cmd->on_done != NULL)
+        cmd->on_done(status, cmd->user_data);
+
+    g_clear_object(&cmd->in);
+    g_clear_object(&cmd->conn);
+    g_clear_object(&cmd->proc);
+    g_clear_object(&cmd->cancellable);
+    g_clear_pointer(&cmd->payload, g_bytes_unref);
+    g_strfreev(cmd->req);
+    g_free(cmd);
+}
+
+static gint failed_status(AsyncCmd *cmd){
+    return cmd->cancel_status != 0 ? cmd->cancel_status : ASYNC_CMD_FAILED;
+}
+
+static gboolean on_failed(gpointer data){
+
+    AsyncCmd *cmd = data;
+
+    cmd->idle_id = 0;
+    finish(cmd, failed_status(cmd));
+
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * Report a command that could not be started. This happens from the main
+ * loop, so the caller of async_cmd_run() always gets a live command back.
+ */
+static void fail_later(AsyncCmd *cmd){
+    cmd->idle_id = g_idle_add(on_failed, cmd);
+}
+
+static void read_next_line(AsyncCmd *cmd);
+
+static void on_proc_exit(GObject *source, GAsyncResult *res, gpointer data){
+
+    AsyncCmd *cmd = data;
+
+    if (!g_subprocess_wait_finish(cmd->proc, res, NULL)) {
+        finish(cmd, failed_status(cmd));
+        return;
+    }
+
+    // Killed by async_cmd_cancel(), or it ran to the end regardless
+    finish(cmd, g_subprocess_get_if_exited(cmd->proc) ? g_subprocess_get_exit_status(cmd->proc) : failed_status(cmd));
+}
+
+static void on_line_read(GObject *source, GAsyncResult *res, gpointer data){
+
+    AsyncCmd *cmd = data;
+    GError *error = NULL;
+    gchar *line = g_data_input_stream_read_line_finish(cmd->in, res, NULL, &error);
+
+    if (error != NULL) {
+        g_error_free(error);
+        finish(cmd, failed_status(cmd));
+        return;
+    }
+
+    if (line == NULL) {
+        // The helper always ends with a status line, a closed pipe means a crash
+        if (cmd->proc != NULL)
+            g_subprocess_wait_async(cmd->proc, cmd->cancellable, on_proc_exit, cmd);
+        else
+            finish(cmd, cmd->status);
+        return;
+    }
+
+    if (cmd->conn != NULL && line[0] == HELPER_EXIT_MARK) {
+        if (strcmp(line + 1, HELPER_CANCELLED) == 0)
+            cmd->status = cmd->cancel_status != 0 ? cmd->cancel_status : ASYNC_CMD_CANCELLED;
+        else
+            cmd->status = (gint) g_ascii_strtoll(line + 1 + strlen("EXIT "), NULL, 10);
+        g_free(line);
+        finish(cmd, cmd->status);
+        return;
+    }
+
+    if (cmd->on_line != NULL)
+        cmd->on_line(line, cmd->user_data);
+
+    g_free(line);
+    read_next_line(cmd);
+}
+
+static void read_next_line(AsyncCmd *cmd){
+    g_data_input_stream_read_line_async(cmd->in, G_PRIORITY_DEFAULT, cmd->cancellable, on_line_read, cmd);
+}
+
+static void start_reading(AsyncCmd *cmd, GInputStream *stream){
+
+    cmd->in = g_data_input_stream_new(stream);
+    g_data_input_stream_set_newline_type(cmd->in, G_DATA_STREAM_NEWLINE_TYPE_LF);
+    read_next_line(cmd);
+}
+
+/**
+ * Run the request through pkexec, without the helper.
+ */
+static void run_fallback(AsyncCmd *cmd){
+
+    const gchar *argv[HELPER_MAX_ARGS + 8] = {"pkexec", "--user", "root"};
+    GSubprocessFlags flags = G_SUBPROCESS_FLAGS_STDOUT_PIPE | G_SUBPROCESS_FLAGS_STDERR_MERGE;
+    guint nreq = g_strv_length(cmd->req);
+    GError *error = NULL;
+
+    if (g_strcmp0(cmd->req[0], HELPER_WRITE_FILE) == 0) {
+        if (nreq != 3) {
+            fail_later(cmd);
+            return;
+        }
+        argv[3] = "tee";
+        argv[4] = cmd->req[1];
+        argv[5] = NULL;
+        flags |= G_SUBPROCESS_FLAGS_STDIN_PIPE;
+    } else if (helper_build_argv(cmd->req, (int) nreq, argv + 3, HELPER_MAX_ARGS + 5) <= 0) {
+        fail_later(cmd);
+        return;
+    }
+
+    cmd->proc = g_subprocess_newv(argv, flags, &error);
+    if (cmd->proc == NULL) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        fail_later(cmd);
+        return;
+    }
+
+    if (flags & G_SUBPROCESS_FLAGS_STDIN_PIPE) {
+        GOutputStream *stdin_pipe = g_subprocess_get_stdin_pipe(cmd->proc);
+        gsize len;
+        const gchar *data = g_bytes_get_data(cmd->payload, &len);
+
+        // Payloads are small files, they fit in the pipe buffer
+        g_output_stream_write_all(stdin_pipe, data, len, NULL, NULL, NULL);
+        g_output_stream_close(stdin_pipe, NULL, NULL);
+    }
+
+    start_reading(cmd, g_subprocess_get_stdout_pipe(cmd->proc));
+}
+
+/**
+ * Ask the helper to interrupt the command. The reply still ends with a
+ * status line, which tells whether it was too late for that.
+ */
+static void send_cancel(AsyncCmd *cmd){
+
+    const gchar mark = HELPER_CANCEL_MARK;
+
+    g_output_stream_write_all(g_io_stream_get_output_stream(G_IO_STREAM(cmd->conn)), &mark, 1, NULL, NULL, NULL);
+}
+
+static void on_request_sent(GObject *source, GAsyncResult *res, gpointer data){
+
+    AsyncCmd *cmd = data;
+
+    if (!g_output_stream_write_all_finish(G_OUTPUT_STREAM(source), res, NULL, NULL)) {
+        finish(cmd, failed_status(cmd));
+        return;
+    }
+
+    cmd->sent = TRUE;
+    // A cancel that came in while writing could not be sent before
+    if (cmd->cancel_status != 0)
+        send_cancel(cmd);
+
+    start_reading(cmd, g_io_stream_get_input_stream(G_IO_STREAM(cmd->conn)));
+}
+
+/**
+ * Connect to a running helper. Connecting to a local socket does not
+ * block, so this is done synchronously.
+ */
+static GSocketConnection *helper_connect(void){
+
+    struct sockaddr_un sa;
+    GSocket *gsocket;
+    GSocketConnection *conn;
+    int fd;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    if (helper_socket_path(sa.sun_path, sizeof(sa.sun_path), getuid()) < 0)
+        return NULL;
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return NULL;
+
+    if (connect(fd, (struct sockaddr *) &sa, sizeof(sa)) < 0 || (gsocket = g_socket_new_from_fd(fd, NULL)) == NULL) {
+        close(fd);
+        return NULL;
+    }
+
+    conn = g_socket_connection_factory_create_connection(gsocket);
+    g_object_unref(gsocket);
+    return conn;
+}
+
+static void send_request(AsyncCmd *cmd){
+
+    GByteArray *buf = g_byte_array_new();
+    GBytes *bytes;
+    gsize len;
+    const guint8 *data;
+
+    for (gchar **p = cmd->req; *p != NULL; p++)
+        g_byte_array_append(buf, (const guint8 *) *p, strlen(*p) + 1);
+    g_byte_array_append(buf, (const guint8 *) "", 1);
+
+    if (cmd->payload != NULL) {
+        data = g_bytes_get_data(cmd->payload, &len);
+        g_byte_array_append(buf, data, len);
+    }
+
+    // Keep the buffer alive until the write completes
+    bytes = g_byte_array_free_to_bytes(buf);
+    g_clear_pointer(&cmd->payload, g_bytes_unref);
+    cmd->payload = bytes;
+
+    data = g_bytes_get_data(bytes, &len);
+    g_output_stream_write_all_async(g_io_stream_get_output_stream(G_IO_STREAM(cmd->conn)), data, len,
+                                    G_PRIORITY_DEFAULT, cmd->cancellable, on_request_sent, cmd);
+}
+
+static void flush_pending(void){
+
+    AsyncCmd *cmd;
+
+    while ((cmd = g_queue_pop_head(&pending)) != NULL)
+        dispatch(cmd);
+}
+
+static void on_helper_line(GObject *source, GAsyncResult *res, gpointer data){
+
+    gchar *line = g_data_input_stream_read_line_finish(helper_out, res, NULL, NULL);
+
+    if (line != NULL && g_str_has_prefix(line, HELPER_READY)) {
+        helper_state = HELPER_RUNNING;
+    } else if (line != NULL) {
+        g_free(line);
+        g_data_input_stream_read_line_async(helper_out, G_PRIORITY_DEFAULT, NULL, on_helper_line, NULL);
+        return;
+    } else {
+        // Authentication dismissed or helper not installed
+        g_printerr("Could not start %s, falling back to pkexec\n", HELPER_BINARY);
+        helper_state = HELPER_UNAVAILABLE;
+        g_clear_object(&helper_proc);
+    }
+
+    g_free(line);
+    g_clear_object(&helper_out);
+    flush_pending();
+}
+
+/**
+ * Start the helper with pkexec. Its stdin pipe is held open by helper_proc
+ * for the lifetime of the GUI; the helper exits when it closes.
+ */
+static void spawn_helper(void){
+
+    const gchar *argv[] = {"pkexec", "--user", "root", HELPER_BINARY, NULL};
+
+    helper_proc = g_subprocess_newv(argv, G_SUBPROCESS_FLAGS_STDIN_PIPE | G_SUBPROCESS_FLAGS_STDOUT_PIPE, NULL);
+    if (helper_proc == NULL) {
+        helper_state = HELPER_UNAVAILABLE;
+        flush_pending();
+        return;
+    }
+
+    helper_state = HELPER_STARTING;
+    helper_out = g_data_input_stream_new(g_subprocess_get_stdout_pipe(helper_proc));
+    g_data_input_stream_read_line_async(helper_out, G_PRIORITY_DEFAULT, NULL, on_helper_line, NULL);
+}
+
+static void dispatch(AsyncCmd *cmd){
+
+    switch (helper_state) {
+        case HELPER_STARTING:
+            g_queue_push_tail(&pending, cmd);
+            return;
+
+        case HELPER_UNAVAILABLE:
+            run_fallback(cmd);
+            return;
+
+        default:
+            break;
+    }
+
+    if ((cmd->conn = helper_connect()) != NULL) {
+        send_request(cmd);
+        return;
+    }
+
+    // A helper we started is gone or unreachable, do not prompt again
+    if (helper_state == HELPER_RUNNING) {
+        g_clear_object(&helper_proc);
+        helper_state = HELPER_UNAVAILABLE;
+        run_fallback(cmd);
+        return;
+    }
+
+    g_queue_push_tail(&pending, cmd);
+    spawn_helper();
+}
+
+static void cancel(AsyncCmd *cmd, gint status){
+
+    if (cmd->cancel_status != 0)
+        return;
+    cmd->cancel_status = status;
+
+    if (cmd->idle_id != 0)
+        return;
+
+    if (g_queue_remove(&pending, cmd)) {
+        finish(cmd, status);
+        return;
+    }
+
+    if (cmd->proc != NULL) {
+        // Only works until pkexec has started the command as root
+        g_subprocess_force_exit(cmd->proc);
+    } else if (cmd->sent) {
+        send_cancel(cmd);
+    } else {
+        // The helper drops a request that is cut short
+        g_cancellable_cancel(cmd->cancellable);
+    }
+}
+
+static gboolean on_timeout(gpointer data){
+
+    AsyncCmd *cmd = data;
+
+    cmd->timeout_id = 0;
+    cancel(cmd, ASYNC_CMD_TIMED_OUT);
+
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * Run a helper request. on_line gets every output line without the
+ * newline, on_done the exit status. A timeout of 0 means none.
+ */
+AsyncCmd *async_cmd_run(const gchar *const *req, guint timeout_sec,
+                        AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer user_data){
+    return async_cmd_run_payload(req, NULL, 0, timeout_sec, on_line, on_done, user_data);
+}
+
+AsyncCmd *async_cmd_run_payload(const gchar *const *req, const gchar *payload, gsize len, guint timeout_sec,
+                                AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer user_data){
+
+    AsyncCmd *cmd = g_new0(AsyncCmd, 1);
+
+    cmd->req = g_strdupv((gchar **) req);
+    cmd->payload = payload != NULL ? g_bytes_new(payload, len) : NULL;
+    cmd->on_line = on_line;
+    cmd->on_done = on_done;
+    cmd->user_data = user_data;
+    cmd->cancellable = g_cancellable_new();
+    cmd->status = ASYNC_CMD_FAILED;
+
+    if (timeout_sec > 0)
+        cmd->timeout_id = g_timeout_add_seconds(timeout_sec, on_timeout, cmd);
+
+    dispatch(cmd);
+    return cmd;
+}
+
+/**
+ * Stop a command. on_done is called with ASYNC_CMD_CANCELLED once it is
+ * stopped, or with its exit status if it could not be stopped in time:
+ * a write-file request, or a command pkexec has already started as root.
+ * Must not be called after on_done.
+ */
+void async_cmd_cancel(AsyncCmd *cmd){
+    cancel(cmd, ASYNC_CMD_CANCELLED);
+}
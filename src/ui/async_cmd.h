@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_ASYNC_CMD_H
+#define WIHOTSPOT_ASYNC_CMD_H
+
+#include <gio/gio.h>
+
+/*
+ * Privileged commands run from the GTK main loop without blocking it.
+ *
+ * Requests go to wihotspot-helper (see helper/helper_proto.h). The helper
+ * is started with pkexec on first use; while the user authenticates the
+ * requests are queued. If it can not be started every request is run with
+ * pkexec directly. In both cases output is read with GIO async calls and
+ * all callbacks run on the main loop.
+ */
+
+#define ASYNC_CMD_FAILED (-1)
+#define ASYNC_CMD_CANCELLED (-2)
+#define ASYNC_CMD_TIMED_OUT (-3)
+
+typedef struct AsyncCmd AsyncCmd;
+
+typedef void (*AsyncCmdLineFunc)(const gchar *line, gpointer user_data);
+
+/**
+ * status is the exit status of the command or one of ASYNC_CMD_*.
+ * The AsyncCmd is freed after this returns.
+ */
+typedef void (*AsyncCmdDoneFunc)(gint status, gpointer user_data);
+
+AsyncCmd *async_cmd_run(const gchar *const *req, guint timeout_sec,
+                        AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer user_data);
+
+AsyncCmd *async_cmd_run_payload(const gchar *const *req, const gchar *payload, gsize len, guint timeout_sec,
+                                AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer user_data);
+
+void async_cmd_cancel(AsyncCmd *cmd);
+
+#endif //WIHOTSPOT_ASYNC_CMD_H
@@ -0,0 +1,507 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include "client_table.h"
+
+#define MIN_SLOTS 64
+#define ARENA_COMPACT_MIN 4096
+
+struct ClientTable {
+    ClientRow *rows;
+    int count;
+    int cap;
+
+    int32_t *slots;             // row index by MAC, -1 if empty
+    uint32_t slot_mask;
+
+    char *arena;                // hostnames, offset 0 is ""
+    uint32_t arena_len;
+    uint32_t arena_cap;
+    uint32_t *str_slots;        // arena offsets by hostname, 0 if empty
+    uint32_t str_mask;
+    uint32_t str_count;
+
+    uint32_t generation;
+
+    unsigned char (*removed)[6];
+    int removed_count;
+    int removed_cap;
+};
+
+static uint32_t hash_bytes(const unsigned char *p, size_t len){
+
+    uint32_t h = 2166136261u;
+
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t hash_mac(const unsigned char *mac){
+    return hash_bytes(mac, 6);
+}
+
+static int32_t *alloc_slots(uint32_t n){
+
+    int32_t *slots = malloc(n * sizeof(int32_t));
+
+    if (slots != NULL)
+        memset(slots, 0xff, n * sizeof(int32_t));
+    return slots;
+}
+
+static int rehash_macs(ClientTable *t, uint32_t n){
+
+    int32_t *slots = alloc_slots(n);
+
+    if (slots == NULL)
+        return -1;
+
+    free(t->slots);
+    t->slots = slots;
+    t->slot_mask = n - 1;
+
+    for (int i = 0; i < t->count; i++) {
+        uint32_t s = hash_mac(t->rows[i].mac) & t->slot_mask;
+        while (t->slots[s] >= 0)
+            s = (s + 1) & t->slot_mask;
+        t->slots[s] = i;
+    }
+    return 0;
+}
+
+/**
+ * Slot holding mac, or the empty slot where it would go.
+ */
+static uint32_t find_slot(const ClientTable *t, const unsigned char *mac){
+
+    uint32_t s = hash_mac(mac) & t->slot_mask;
+
+    while (t->slots[s] >= 0 && memcmp(t->rows[t->slots[s]].mac, mac, 6) != 0)
+        s = (s + 1) & t->slot_mask;
+
+    return s;
+}
+
+/**
+ * Empty slot s and shift the following entries of its probe run back, so
+ * lookups never stop early at the hole.
+ */
+static void delete_slot(ClientTable *t, uint32_t s){
+
+    uint32_t mask = t->slot_mask;
+    uint32_t k = (s + 1) & mask;
+
+    while (t->slots[k] >= 0) {
+        uint32_t h = hash_mac(t->rows[t->slots[k]].mac) & mask;
+
+        // Move the entry unless its home slot lies cyclically in (s, k]
+        if (((k - h) & mask) >= ((k - s) & mask)) {
+            t->slots[s] = t->slots[k];
+            s = k;
+        }
+        k = (k + 1) & mask;
+    }
+
+    t->slots[s] = -1;
+}
+
+static uint32_t arena_add(ClientTable *t, const char *str, size_t len){
+
+    uint32_t off;
+
+    if (t->arena_len + len + 1 > t->arena_cap) {
+        uint32_t cap = t->arena_cap * 2;
+        char *n;
+
+        while (cap < t->arena_len + len + 1)
+            cap *= 2;
+        if ((n = realloc(t->arena, cap)) == NULL)
+            return 0;
+        t->arena = n;
+        t->arena_cap = cap;
+    }
+
+    off = t->arena_len;
+    memcpy(t->arena + off, str, len);
+    t->arena[off + len] = '\0';
+    t->arena_len += len + 1;
+    return off;
+}
+
+static int grow_strings(ClientTable *t){
+
+    uint32_t n = (t->str_mask + 1) * 2;
+    uint32_t *slots = calloc(n, sizeof(uint32_t));
+
+    if (slots == NULL)
+        return -1;
+
+    for (uint32_t i = 0; i <= t->str_mask; i++) {
+        uint32_t off = t->str_slots[i];
+        uint32_t s;
+
+        if (off == 0)
+            continue;
+        s = hash_bytes((const unsigned char *) t->arena + off, strlen(t->arena + off)) & (n - 1);
+        while (slots[s] != 0)
+            s = (s + 1) & (n - 1);
+        slots[s] = off;
+    }
+
+    free(t->str_slots);
+    t->str_slots = slots;
+    t->str_mask = n - 1;
+    return 0;
+}
+
+/**
+ * Arena offset of str, adding it if it is not there yet.
+ * Unknown hostnames ("*" in dnsmasq leases) map to 0.
+ */
+static uint32_t intern(ClientTable *t, const char *str){
+
+    size_t len;
+    uint32_t s;
+
+    if (str == NULL || str[0] == '\0' || strcmp(str, "*") == 0)
+        return 0;
+
+    if ((t->str_count + 1) * 2 > t->str_mask + 1 && grow_strings(t) < 0)
+        return 0;
+
+    len = strlen(str);
+    s = hash_bytes((const unsigned char *) str, len) & t->str_mask;
+
+    while (t->str_slots[s] != 0) {
+        if (strcmp(t->arena + t->str_slots[s], str) == 0)
+            return t->str_slots[s];
+        s = (s + 1) & t->str_mask;
+    }
+
+    if ((t->str_slots[s] = arena_add(t, str, len)) != 0)
+        t->str_count++;
+    return t->str_slots[s];
+}
+
+/**
+ * Drop hostnames no row refers to any more once they make up most of the
+ * arena.
+ */
+static void compact_arena(ClientTable *t){
+
+    uint32_t live = 1;
+    char *old = t->arena;
+
+    for (int i = 0; i < t->count; i++) {
+        if (t->rows[i].hostname != 0)
+            live += strlen(old + t->rows[i].hostname) + 1;
+    }
+
+    if (t->arena_len < ARENA_COMPACT_MIN || t->arena_len < live * 2)
+        return;
+
+    if ((t->arena = malloc(t->arena_cap)) == NULL) {
+        t->arena = old;
+        return;
+    }
+    t->arena[0] = '\0';
+    t->arena_len = 1;
+    memset(t->str_slots, 0, (t->str_mask + 1) * sizeof(uint32_t));
+    t->str_count = 0;
+
+    for (int i = 0; i < t->count; i++) {
+        if (t->rows[i].hostname != 0)
+            t->rows[i].hostname = intern(t, old + t->rows[i].hostname);
+    }
+
+    free(old);
+}
+
+ClientTable *client_table_new(void){
+
+    ClientTable *t = calloc(1, sizeof(ClientTable));
+
+    if (t == NULL)
+        return NULL;
+
+    t->slots = alloc_slots(MIN_SLOTS);
+    t->slot_mask = MIN_SLOTS - 1;
+    t->str_slots = calloc(MIN_SLOTS, sizeof(uint32_t));
+    t->str_mask = MIN_SLOTS - 1;
+    t->arena_cap = 1024;
+    t->arena = malloc(t->arena_cap);
+
+    if (t->slots == NULL || t->str_slots == NULL || t->arena == NULL) {
+        client_table_free(t);
+        return NULL;
+    }
+
+    t->arena[0] = '\0';
+    t->arena_len = 1;
+    return t;
+}
+
+void client_table_free(ClientTable *t){
+
+    if (t == NULL)
+        return;
+
+    free(t->rows);
+    free(t->slots);
+    free(t->arena);
+    free(t->str_slots);
+    free(t->removed);
+    free(t);
+}
+
+void client_table_begin(ClientTable *t){
+    t->generation++;
+    t->removed_count = 0;
+}
+
+/**
+ * Row for mac, added if missing, and marked seen in this refresh.
+ */
+static ClientRow *get_row(ClientTable *t, const unsigned char *mac){
+
+    uint32_t s = find_slot(t, mac);
+    ClientRow *row;
+
+    if (t->slots[s] >= 0) {
+        row = &t->rows[t->slots[s]];
+        if (row->seen != t->generation)
+            row->state = CLIENT_UNCHANGED;
+        row->seen = t->generation;
+        return row;
+    }
+
+    if (t->count == t->cap) {
+        int cap = t->cap ? t->cap * 2 : 32;
+        ClientRow *n = realloc(t->rows, cap * sizeof(ClientRow));
+        if (n == NULL)
+            return NULL;
+        t->rows = n;
+        t->cap = cap;
+    }
+
+    if ((uint32_t) (t->count + 1) * 2 > t->slot_mask + 1) {
+        if (rehash_macs(t, (t->slot_mask + 1) * 2) < 0)
+            return NULL;
+        s = find_slot(t, mac);
+    }
+
+    row = &t->rows[t->count];
+    memset(row, 0, sizeof(ClientRow));
+    memcpy(row->mac, mac, 6);
+    row->state = CLIENT_ADDED;
+    row->seen = t->generation;
+    t->slots[s] = t->count++;
+    return row;
+}
+
+static void mark_changed(ClientRow *row){
+    if (row->state == CLIENT_UNCHANGED)
+        row->state = CLIENT_CHANGED;
+}
+
+/**
+ * Insert a station or update its counters. The counters move with every
+ * dump, so they are written in place and do not mark the row changed. The
+ * lease is set separately with client_table_set_lease(). Returns the row
+ * index, or -1.
+ */
+int client_table_update(ClientTable *t, const StationInfo *st){
+
+    ClientRow *row = get_row(t, st->mac);
+
+    if (row == NULL)
+        return -1;
+
+    row->has_signal = (uint8_t) st->has_signal;
+    row->signal = (int8_t) st->signal;
+    row->rx_bytes = st->rx_bytes;
+    row->tx_bytes = st->tx_bytes;
+    row->rx_packets = st->rx_packets;
+    row->tx_packets = st->tx_packets;
+    row->tx_retries = st->tx_retries;
+    row->tx_failed = st->tx_failed;
+    row->tx_bitrate = st->tx_bitrate;
+    row->inactive_time = st->inactive_time;
+    row->connected_time = st->connected_time;
+
+    return (int) (row - t->rows);
+}
+
+/**
+ * Update the lease of an existing row without touching its counters.
+ * Returns the row index, or -1 if mac is not in the table.
+ */
+int client_table_set_lease(ClientTable *t, const unsigned char *mac, uint32_t ipv4, const char *hostname){
+
+    int i = client_table_find(t, mac);
+    uint32_t off;
+    ClientRow *row;
+
+    if (i < 0)
+        return -1;
+
+    row = &t->rows[i];
+    off = intern(t, hostname);
+
+    if (row->ipv4 != ipv4 || row->hostname != off) {
+        row->ipv4 = ipv4;
+        row->hostname = off;
+        mark_changed(row);
+    }
+    return i;
+}
+
+static void remove_row(ClientTable *t, int i){
+
+    int last = t->count - 1;
+
+    delete_slot(t, find_slot(t, t->rows[i].mac));
+
+    if (i != last) {
+        t->rows[i] = t->rows[last];
+        t->slots[find_slot(t, t->rows[i].mac)] = i;
+    }
+    t->count--;
+}
+
+/**
+ * Remove the rows that were not updated since client_table_begin().
+ * Returns the number of rows added, changed or removed.
+ */
+int client_table_end(ClientTable *t){
+
+    int changes = 0;
+    int i = 0;
+
+    while (i < t->count) {
+        ClientRow *row = &t->rows[i];
+
+        if (row->seen == t->generation) {
+            changes += row->state != CLIENT_UNCHANGED;
+            i++;
+            continue;
+        }
+
+        if (t->removed_count == t->removed_cap) {
+            int cap = t->removed_cap ? t->removed_cap * 2 : 16;
+            unsigned char (*n)[6] = realloc(t->removed, cap * sizeof(*n));
+            if (n != NULL) {
+                t->removed = n;
+                t->removed_cap = cap;
+            }
+        }
+        if (t->removed_count < t->removed_cap)
+            memcpy(t->removed[t->removed_count++], row->mac, 6);
+
+        remove_row(t, i);
+        changes++;
+    }
+
+    compact_arena(t);
+    return changes;
+}
+
+/**
+ * Remove the row of mac between refreshes, e.g. when the station left.
+ * Returns 0, or -1 if mac is not in the table.
+ */
+int client_table_remove(ClientTable *t, const unsigned char *mac){
+
+    int i = client_table_find(t, mac);
+
+    if (i < 0)
+        return -1;
+
+    remove_row(t, i);
+    return 0;
+}
+
+int client_table_count(const ClientTable *t){
+    return t->count;
+}
+
+const ClientRow *client_table_row(const ClientTable *t, int i){
+
+    if (i < 0 || i >= t->count)
+        return NULL;
+
+    return &t->rows[i];
+}
+
+int client_table_find(const ClientTable *t, const unsigned char *mac){
+    return t->slots[find_slot(t, mac)];
+}
+
+const char *client_table_hostname(const ClientTable *t, const ClientRow *row){
+    return row->hostname != 0 ? t->arena + row->hostname : "*";
+}
+
+/**
+ * MAC addresses removed by the last client_table_end().
+ */
+int client_table_removed_count(const ClientTable *t){
+    return t->removed_count;
+}
+
+const unsigned char *client_table_removed(const ClientTable *t, int i){
+
+    if (i < 0 || i >= t->removed_count)
+        return NULL;
+
+    return t->removed[i];
+}
+
+void client_format_mac(const unsigned char *mac, char *buf){
+    snprintf(buf, 18, "%02x:%02x:%02x:%02x:%02x:%02x",
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+void client_format_ipv4(uint32_t ipv4, char *buf){
+
+    struct in_addr addr;
+
+    if (ipv4 == 0) {
+        strcpy(buf, "*");
+        return;
+    }
+
+    addr.s_addr = ipv4;
+    inet_ntop(AF_INET, &addr, buf, INET_ADDRSTRLEN);
+}
@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_CLIENT_TABLE_H
+#define WIHOTSPOT_CLIENT_TABLE_H
+
+#include <stdint.h>
+#include <netinet/in.h>
+
+#include "station.h"
+
+/*
+ * Table of the clients of a hotspot.
+ *
+ * Rows are stored contiguously and indexed by MAC address with an open
+ * addressing hash. Hostnames live in a string arena shared by all rows.
+ *
+ * A refresh is applied as a diff: call client_table_begin(), update every
+ * station that is still there, then client_table_end(). Only rows whose
+ * lease differs are marked changed, and rows that were not seen are removed.
+ * The station counters are always current.
+ *
+ * Between refreshes a single station can be updated the same way, without
+ * client_table_begin(), or dropped with client_table_remove().
+ */
+
+#define CLIENT_UNCHANGED 0
+#define CLIENT_ADDED 1
+#define CLIENT_CHANGED 2
+
+typedef struct {
+    unsigned char mac[6];
+    uint8_t state;              // CLIENT_* of the last refresh
+    uint8_t has_signal;
+    int8_t signal;              // dBm
+    uint32_t ipv4;              // network byte order, 0 without a lease
+    uint32_t hostname;          // arena offset, 0 if unknown
+    uint32_t seen;              // refresh generation
+
+    uint64_t rx_bytes;
+    uint64_t tx_bytes;
+    uint32_t rx_packets;
+    uint32_t tx_packets;
+    uint32_t tx_retries;
+    uint32_t tx_failed;
+    uint32_t tx_bitrate;        // 100 kbit/s
+    uint32_t inactive_time;     // ms
+    uint32_t connected_time;    // s
+} ClientRow;
+
+typedef struct ClientTable ClientTable;
+
+ClientTable *client_table_new(void);
+void client_table_free(ClientTable *t);
+
+void client_table_begin(ClientTable *t);
+int client_table_update(ClientTable *t, const StationInfo *st);
+int client_table_set_lease(ClientTable *t, const unsigned char *mac, uint32_t ipv4, const char *hostname);
+int client_table_end(ClientTable *t);
+int client_table_remove(ClientTable *t, const unsigned char *mac);
+
+int client_table_count(const ClientTable *t);
+const ClientRow *client_table_row(const ClientTable *t, int i);
+int client_table_find(const ClientTable *t, const unsigned char *mac);
+const char *client_table_hostname(const ClientTable *t, const ClientRow *row);
+
+int client_table_removed_count(const ClientTable *t);
+const unsigned char *client_table_removed(const ClientTable *t, int i);
+
+void client_format_mac(const unsigned char *mac, char *buf);
+void client_format_ipv4(uint32_t ipv4, char *buf);
+
+#endif //WIHOTSPOT_CLIENT_TABLE_H
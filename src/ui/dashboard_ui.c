@@ -0,0 +1,335 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <gtk/gtk.h>
+
+#include "dashboard_ui.h"
+#include "h_prop.h"
+#include "instance_status.h"
+#include "read_config.h"
+#include "traffic.h"
+
+#define DASHBOARD_RESPONSE_REFRESH 1
+
+typedef struct {
+    pid_t pid;
+    GtkWidget *row;
+    GtkLabel *label_iface;
+    GtkLabel *label_ssid;
+    GtkLabel *label_clients;
+    GtkLabel *label_uptime;
+    GtkLabel *label_rate;
+    GtkWidget *button_stop;
+} DashboardRow;
+
+static GtkBuilder *builder;
+static GtkDialog *dialog;
+static GtkListBox *list_instances;
+
+// DashboardRow of every listed instance, by pid
+static GHashTable *rows;
+static guint sample_id;
+
+static gchar *format_uptime(long uptime){
+
+    if (uptime < 0)
+        return g_strdup("-");
+    if (uptime < 60)
+        return g_strdup_printf("%ld s", uptime);
+    if (uptime < 3600)
+        return g_strdup_printf("%ld min %02ld s", uptime / 60, uptime % 60);
+    if (uptime < 86400)
+        return g_strdup_printf("%ld h %02ld min", uptime / 3600, uptime % 3600 / 60);
+    return g_strdup_printf("%ld d %02ld h", uptime / 86400, uptime % 86400 / 3600);
+}
+
+/**
+ * Latest rate of the access point as "down / up", the download being what
+ * it transmits.
+ */
+static gchar *format_ap_rate(const InstanceStatus *s){
+
+    const TrafficHistory *h = s->traffic != NULL ? traffic_monitor_iface(s->traffic, TRAFFIC_IFACE_AP) : NULL;
+    float rx, tx;
+    gchar *down, *up, *text;
+
+    if (h == NULL || traffic_history_len(h) == 0)
+        return g_strdup("-");
+
+    traffic_history_get(h, traffic_history_len(h) - 1, &rx, &tx);
+    down = g_format_size((guint64) tx);
+    up = g_format_size((guint64) rx);
+    text = g_strdup_printf("↓ %s/s  ↑ %s/s", down, up);
+
+    g_free(down);
+    g_free(up);
+    return text;
+}
+
+static void show_status(DashboardRow *r, const InstanceStatus *s){
+
+    gchar *text;
+
+    gtk_label_set_text(r->label_iface, s->iface);
+    gtk_label_set_text(r->label_ssid, s->ssid[0] != '\0' ? s->ssid : "-");
+
+    text = s->clients >= 0 ? g_strdup_printf("%d", s->clients) : g_strdup("-");
+    gtk_label_set_text(r->label_clients, text);
+    g_free(text);
+
+    text = format_uptime(s->uptime);
+    gtk_label_set_text(r->label_uptime, text);
+    g_free(text);
+
+    text = format_ap_rate(s);
+    gtk_label_set_text(r->label_rate, text);
+    g_free(text);
+}
+
+static void on_row_stopped(gint status, gpointer data){
+
+    DashboardRow *r;
+
+    // The row is gone by now unless stopping failed
+    update_dashboard();
+
+    r = g_hash_table_lookup(rows, data);
+    if (status == 0 || r == NULL)
+        return;
+
+    gtk_widget_set_sensitive(r->button_stop, TRUE);
+    gtk_button_set_label(GTK_BUTTON(r->button_stop), "Stop");
+
+    GtkWidget *message = gtk_message_dialog_new(GTK_WINDOW(dialog), GTK_DIALOG_MODAL,
+                                                GTK_MESSAGE_ERROR, GTK_BUTTONS_CLOSE,
+                                                "Could not stop the hotspot on %s", gtk_label_get_text(r->label_iface));
+    gtk_dialog_run(GTK_DIALOG(message));
+    gtk_widget_destroy(message);
+}
+
+static void on_row_stop_clicked(GtkWidget *widget, gpointer data){
+
+    DashboardRow *r = g_hash_table_lookup(rows, data);
+    gchar *pid;
+
+    if (r == NULL)
+        return;
+
+    gtk_widget_set_sensitive(r->button_stop, FALSE);
+    gtk_button_set_label(GTK_BUTTON(r->button_stop), "Stopping ...");
+
+    pid = g_strdup_printf("%d", (int) r->pid);
+    stop_hotspot(pid, on_row_stopped, data);
+    g_free(pid);
+}
+
+static void on_row_refresh_clicked(GtkWidget *widget, gpointer data){
+
+    DashboardRow *r = g_hash_table_lookup(rows, data);
+
+    if (r == NULL)
+        return;
+
+    if (instance_status_refresh_one(r->pid) == 0)
+        show_status(r, instance_status_find(r->pid));
+    else
+        update_dashboard();
+}
+
+static GtkLabel *add_row_label(GtkWidget *box, int width_chars, gboolean expand){
+
+    GtkWidget *label = gtk_label_new("-");
+
+    gtk_label_set_width_chars(GTK_LABEL(label), width_chars);
+    gtk_label_set_ellipsize(GTK_LABEL(label), PANGO_ELLIPSIZE_END);
+    gtk_label_set_xalign(GTK_LABEL(label), 0);
+    gtk_box_pack_start(GTK_BOX(box), label, expand, TRUE, 0);
+    return GTK_LABEL(label);
+}
+
+static DashboardRow *add_row(pid_t pid){
+
+    DashboardRow *r = g_new0(DashboardRow, 1);
+    GtkWidget *box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
+    GtkWidget *button_refresh = gtk_button_new_with_label("Refresh");
+    gpointer key = GINT_TO_POINTER(pid);
+    gchar *tooltip = g_strdup_printf("PID %d", (int) pid);
+
+    r->pid = pid;
+    r->label_iface = add_row_label(box, 10, FALSE);
+    r->label_ssid = add_row_label(box, 16, TRUE);
+    r->label_clients = add_row_label(box, 4, FALSE);
+    r->label_uptime = add_row_label(box, 12, FALSE);
+    r->label_rate = add_row_label(box, 26, FALSE);
+    r->button_stop = gtk_button_new_with_label("Stop");
+
+    gtk_widget_set_tooltip_text(GTK_WIDGET(r->label_clients), "Connected devices");
+    gtk_widget_set_tooltip_text(GTK_WIDGET(r->label_uptime), "Uptime");
+    gtk_widget_set_tooltip_text(GTK_WIDGET(r->label_iface), tooltip);
+    g_free(tooltip);
+
+    gtk_box_pack_end(GTK_BOX(box), r->button_stop, FALSE, FALSE, 0);
+    gtk_box_pack_end(GTK_BOX(box), button_refresh, FALSE, FALSE, 0);
+    g_signal_connect(button_refresh, "clicked", G_CALLBACK(on_row_refresh_clicked), key);
+    g_signal_connect(r->button_stop, "clicked", G_CALLBACK(on_row_stop_clicked), key);
+
+    gtk_widget_set_margin_start(box, 6);
+    gtk_widget_set_margin_end(box, 6);
+    gtk_widget_set_margin_top(box, 4);
+    gtk_widget_set_margin_bottom(box, 4);
+
+    r->row = gtk_list_box_row_new();
+    gtk_container_add(GTK_CONTAINER(r->row), box);
+    gtk_list_box_insert(list_instances, r->row, -1);
+    gtk_widget_show_all(r->row);
+
+    g_hash_table_insert(rows, key, r);
+    return r;
+}
+
+static void free_row(gpointer data){
+
+    DashboardRow *r = data;
+
+    gtk_widget_destroy(r->row);
+    g_free(r);
+}
+
+static gboolean row_stopped(gpointer key, gpointer value, gpointer data){
+    return instance_status_find(GPOINTER_TO_INT(key)) == NULL;
+}
+
+/**
+ * Refresh every instance at once and bring the list in line: rows of
+ * instances that stopped go away, new ones are appended.
+ */
+static void refresh_all(void){
+
+    instance_status_refresh();
+
+    g_hash_table_foreach_remove(rows, row_stopped, NULL);
+
+    for (int i = 0; i < instance_status_count(); i++) {
+        const InstanceStatus *s = instance_status_get(i);
+        DashboardRow *r = g_hash_table_lookup(rows, GINT_TO_POINTER(s->pid));
+
+        if (r == NULL)
+            r = add_row(s->pid);
+        show_status(r, s);
+    }
+}
+
+static gboolean on_sample(gpointer data){
+
+    refresh_all();
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * Sampling only runs while the dialog is shown; the traffic history of the
+ * instances is dropped when it is hidden.
+ */
+static void stop_sampling(void){
+
+    if (sample_id != 0) {
+        g_source_remove(sample_id);
+        sample_id = 0;
+    }
+
+    g_hash_table_remove_all(rows);
+    instance_status_clear();
+}
+
+static gboolean on_delete(GtkWidget *widget, GdkEvent *event, gpointer data){
+
+    stop_sampling();
+    return gtk_widget_hide_on_delete(widget);
+}
+
+static void on_response(GtkDialog *d, gint response, gpointer data){
+
+    if (response == DASHBOARD_RESPONSE_REFRESH) {
+        refresh_all();
+        return;
+    }
+
+    stop_sampling();
+    gtk_widget_hide(GTK_WIDGET(d));
+}
+
+static void init_dialog(GtkWidget *parent){
+
+    GError *error = NULL;
+    GtkWidget *placeholder;
+
+    builder = gtk_builder_new();
+    //Load ui description from built resource - need to generate compiled source with glib-compile-resource
+    if (gtk_builder_add_from_resource(builder,"/org/gtk/wihotspot/dashboard.glade",&error) == 0) {
+        g_printerr("Could not load the dashboard: %s\n", error->message);
+        g_error_free(error);
+        g_clear_object(&builder);
+        return;
+    }
+
+    dialog = GTK_DIALOG(gtk_builder_get_object(builder, "dialog_dashboard"));
+    list_instances = GTK_LIST_BOX(gtk_builder_get_object(builder, "list_instances"));
+
+    placeholder = gtk_label_new("No hotspot is running");
+    gtk_widget_show(placeholder);
+    gtk_list_box_set_placeholder(list_instances, placeholder);
+
+    rows = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free_row);
+
+    g_signal_connect(dialog, "delete-event", G_CALLBACK(on_delete), NULL);
+    g_signal_connect(dialog, "response", G_CALLBACK(on_response), NULL);
+
+    if (parent != NULL)
+        gtk_window_set_transient_for(GTK_WINDOW(dialog), GTK_WINDOW(gtk_widget_get_toplevel(parent)));
+}
+
+void open_dashboard(GtkWidget *widget, gpointer root){
+
+    if (dialog == NULL)
+        init_dialog(widget);
+    if (dialog == NULL)
+        return;
+
+    refresh_all();
+    if (sample_id == 0)
+        sample_id = g_timeout_add(traffic_sample_interval(getConfigValues()->traffic_sample_ms), on_sample, NULL);
+
+    gtk_window_present(GTK_WINDOW(dialog));
+}
+
+void update_dashboard(void){
+
+    // a hidden dashboard is filled by the next open_dashboard()
+    if (dialog == NULL || !gtk_widget_get_visible(GTK_WIDGET(dialog)))
+        return;
+
+    refresh_all();
+}
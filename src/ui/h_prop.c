@@ -31,179 +31,185 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <limits.h>
+#include <glob.h>
+#include <net/if.h>
 //#include <libconfig.h>
 
 #include "h_prop.h"
 #include "read_config.h"
-#include "qrgen.h"
+#include "validator.h"
+#include "iface_list.h"
+#include "async_cmd.h"
+#include "station.h"
+#include "client_table.h"
+#include "lease_tracker.h"
+#include "traffic.h"
+#include "../helper/helper_proto.h"
 
 
 #define BUFSIZE 2048
 
 
-#define SUDO "pkexec --user root"
-#define CREATE_AP "create_ap"
+#define CREATE_AP_CONFDIR_GLOB "/tmp/create_ap.*.conf.*"
+#define CREATE_AP_REGISTRY_PID "/run/create_ap/pid"
 
-#define MKCONFIG "--mkconfig"
-#define LOAD_CONFIG "--config"
-#define STOP "--stop"
+#define CMD_TIMEOUT 120
 
 
-static char cmd_start[BUFSIZE];
-static char cmd_mkconfig[BUFSIZE];
-static char cmd_config[BUFSIZE];
-static char cmd_kill[BUFSIZE];
-static char cmd_write_mac[BUFSIZE];
-
 static char h_running_info[BUFSIZE];
-static char interface_list[BUFSIZE];
-static char wifi_interface_list[BUFSIZE];
-static char accepted_macs[BUFSIZE];
 
 static const char* g_ssid=NULL;
 static const char* g_pass=NULL;
 
-static char* qr_image_path;
 
 //config_t cfg;
 
-static int parse_output(const char *cmd) {
-
-    char buf[BUFSIZE];
-    FILE *fp;
-
-    if ((fp = popen(cmd, "r")) == NULL) {
-        printf("Error opening pipe!\n");
-        return -1;
-    }
+typedef struct {
+    gchar* config;
+    gsize length;
+    AsyncCmdDoneFunc done;
+    gpointer data;
+} ConfigWrite;
 
-    while (fgets(buf, BUFSIZE, fp) != NULL) {
-        // Do whatever you want here...
-        printf("%s", buf);
-    }
+typedef struct {
+    RunningInfoFunc done;
+    gpointer data;
+} RunningQuery;
 
-    if (pclose(fp)) {
-        printf("Command not found or exited with error status\n");
-        return -1;
-    }
-
-    return 0;
+static void print_line(const gchar* line, gpointer data){
+    printf("%s\n", line);
 }
 
+static AsyncCmd* write_file(const char* path, const char* data, gsize length, AsyncCmdDoneFunc on_done, gpointer user_data){
 
-const char *build_wh_start_command(char *iface_src, char *iface_dest, char *ssid, char *pass) {
+    char size[32];
+    const gchar* argv[]={HELPER_WRITE_FILE, path, size, NULL};
 
-    snprintf(cmd_start, BUFSIZE, "%s %s %s %s %s %s", SUDO, CREATE_AP, iface_src, iface_dest, ssid, pass);
+    snprintf(size,sizeof(size),"%zu",(size_t)length);
 
-    return cmd_start;
+    return async_cmd_run_payload(argv,data,length,CMD_TIMEOUT,NULL,on_done,user_data);
 }
 
+static void on_config_written(gint status, gpointer data){
 
-const char *build_wh_mkconfig_command(ConfigValues* cv){
-
-    const char* config_ffile_name=get_config_file(CONFIG_FILE_NAME);
+    ConfigWrite* cw=data;
 
-    snprintf(cmd_mkconfig, BUFSIZE, "%s %s %s %s '%s' '%s' %s %s",SUDO, CREATE_AP, cv->iface_wifi, cv->iface_inet, cv->ssid, cv->pass,MKCONFIG,config_ffile_name);
-
-    if(cv->freq!=NULL){
-        strcat(cmd_mkconfig," --freq-band ");
-        strcat(cmd_mkconfig,cv->freq);
-    }
+    if(status!=0)
+        printf("Could not write the config file\n");
 
-    if(cv->no_virt!=NULL && (strcmp(cv->no_virt,"1") == 0))
-        strcat(cmd_mkconfig," --no-virt ");
+    cw->done(status,cw->data);
+    g_free(cw->config);
+    g_free(cw);
+}
 
-    if(cv->use_psk!=NULL && (strcmp(cv->use_psk,"1") == 0))
-        strcat(cmd_mkconfig," --psk ");
+static void on_macs_written(gint status, gpointer data){
 
-    if(cv->hidden!=NULL && (strcmp(cv->hidden,"1") == 0))
-        strcat(cmd_mkconfig," --hidden ");
+    ConfigWrite* cw=data;
 
-    if(cv->no_haveged!=NULL && (strcmp(cv->no_haveged,"1") == 0))
-        strcat(cmd_mkconfig," --no-haveged ");
+    // Do not start with a stale accept list
+    if(status!=0){
+        printf("Could not write the MAC filter file\n");
+        cw->done(status,cw->data);
+        g_free(cw->config);
+        g_free(cw);
+        return;
+    }
 
-    if(cv->channel!=NULL && (strcmp(cv->channel,"default") != 0) && (cv->freq==NULL||(strcmp(cv->freq,"2.4") == 0)|| (strcmp(cv->freq,"5") == 0))){
+    write_file(get_config_file(CONFIG_FILE_NAME),cw->config,cw->length,on_config_written,cw);
+}
 
-            strcat(cmd_mkconfig," -c ");
-            strcat(cmd_mkconfig,cv->channel);
-    }
+static int is_set(const char* value){
+    return value!=NULL && (strcmp(value,"1") == 0);
+}
 
-    if(cv->ieee80211n!=NULL && (strcmp(cv->ieee80211n,"1") == 0)){
-        strcat(cmd_mkconfig," --ieee80211n ");
-    }
-    
-    if(cv->ieee80211ac!=NULL && (strcmp(cv->ieee80211ac,"1") == 0)){
-        strcat(cmd_mkconfig," --ieee80211ac ");
-    }
+/**
+ * Save the config for the given values, after the MAC filter file if one is
+ * used. The file is serialized here and written by one privileged request.
+ */
+void write_hotspot_config(ConfigValues* cv, AsyncCmdDoneFunc done, gpointer data){
 
-    if(cv->ieee80211ax!=NULL && (strcmp(cv->ieee80211ax,"1") == 0)){
-        strcat(cmd_mkconfig," --ieee80211ax ");
+    char buf[BUFSIZE];
+    int length;
+    ConfigWrite* cw;
+
+    length=serialize_config_values(cv,buf,sizeof(buf));
+    if(length<0){
+        printf("Config values can not be saved\n");
+        done(ASYNC_CMD_FAILED,data);
+        return;
     }
 
-    if(cv->mac!=NULL) {
-        strcat(cmd_mkconfig, " --mac ");
-        strcat(cmd_mkconfig, cv->mac);
-    }
+    cw=g_new0(ConfigWrite,1);
+    cw->config=g_strndup(buf,length);
+    cw->length=length;
+    cw->done=done;
+    cw->data=data;
 
-    if(cv->gateway!=NULL) {
-        strcat(cmd_mkconfig, " -g ");
-        strcat(cmd_mkconfig, cv->gateway);
-    }
+    if(is_set(cv->mac_filter))
+        write_accepted_macs(cv->accepted_mac_file,cv->accepted_macs,on_macs_written,cw);
+    else
+        write_file(get_config_file(CONFIG_FILE_NAME),cw->config,cw->length,on_config_written,cw);
+}
 
-    if(cv->mac_filter!=NULL && (strcmp(cv->mac_filter,"1") == 0)){
-        strcat(cmd_mkconfig, " --mac-filter ");
-        strcat(cmd_mkconfig, cv->mac_filter);
-        write_accepted_macs(cv->accepted_mac_file,cv->accepted_macs);
-    }
+/**
+ * Start create_ap from the saved config. on_line gets its output; it keeps
+ * running after AP-ENABLED, so on_done is only called once it exits.
+ */
+AsyncCmd* start_hotspot(const char* freq, AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer data){
 
-    printf("%s \n",cmd_mkconfig);
-    return cmd_mkconfig;
+    const gchar* argv[]={HELPER_START, get_config_file(CONFIG_FILE_NAME), freq, NULL};
 
+    return async_cmd_run(argv,0,on_line,on_done,data);
 }
 
-const char *build_wh_from_config(){
+/**
+ * Apply the saved config to the running instance pid without restarting it.
+ * on_done gets HELPER_RELOAD_NEEDS_RESTART if a change can not be applied
+ * in place.
+ */
+AsyncCmd* reload_hotspot(const char* pid, const char* freq, AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer data){
 
-    snprintf(cmd_config, BUFSIZE, "%s %s %s %s", SUDO, CREATE_AP,LOAD_CONFIG,get_config_file(CONFIG_FILE_NAME));
-    return cmd_config;
+    const gchar* argv[]={HELPER_RELOAD, get_config_file(CONFIG_FILE_NAME), pid, freq, NULL};
 
+    return async_cmd_run(argv,CMD_TIMEOUT,on_line,on_done,data);
 }
 
-int startShell(const char *cmd) {
-    return parse_output(cmd);
-}
+AsyncCmd* stop_hotspot(const char* pid, AsyncCmdDoneFunc on_done, gpointer data){
 
+    const gchar* argv[]={HELPER_STOP, pid, NULL};
 
-const char* build_kill_create_ap_command(char* pid){
-    snprintf(cmd_kill, BUFSIZE, "%s %s %s %s", SUDO, CREATE_AP,STOP,pid);
-    return cmd_kill;
+    return async_cmd_run(argv,CMD_TIMEOUT,print_line,on_done,data);
 }
 
-void write_accepted_macs(char* filename, char* accepted_macs){
+AsyncCmd* write_accepted_macs(char* filename, char* accepted_macs, AsyncCmdDoneFunc on_done, gpointer data){
+
+    size_t len = strlen(accepted_macs);
+    gchar *buf = g_malloc(len + 2);
+    AsyncCmd *cmd;
 
     printf("mac filter file %s \n",filename);
 
-    snprintf(cmd_write_mac,BUFSIZE,"%s '%s' %s %s","echo", accepted_macs, "| pkexec -u root tee", filename);
-    int r=system(cmd_write_mac);
+    // hostapd gets the canonical list, text that does not parse is kept as is
+    if (validator_mac_list(accepted_macs, len, buf, NULL, 0, NULL) < 0)
+        snprintf(buf, len + 2, "%s\n", accepted_macs);
 
+    cmd = write_file(filename,buf,strlen(buf),on_done,data);
+    g_free(buf);
+    return cmd;
 }
 
 char * read_mac_filter_file(char * filename){
 
-    char ch;
-    FILE *fp;
+    static gchar *accepted_macs;
 
-    fp = fopen(filename, "r"); // read mode
+    g_free(accepted_macs);
+    accepted_macs = NULL;
 
-    if (fp == NULL)
-    {
+    if (!g_file_get_contents(filename, &accepted_macs, NULL, NULL))
         return NULL;
-    }
 
-    while((ch = (char)fgetc(fp)) != EOF)
-        strcat(accepted_macs, &ch);
-
-   fclose(fp);
-   return accepted_macs;
+    return accepted_macs;
 }
 
 //int write_config(char* file){
@@ -240,44 +246,17 @@ char * read_mac_filter_file(char * filename){
 //}
 
 
-static int init_get_running(){
-
-    char cmd[BUFSIZE];
-    snprintf(cmd, BUFSIZE, "%s %s --list-running",SUDO, CREATE_AP);
-
-    FILE *fp;
-
-    if ((fp = popen(cmd, "r")) == NULL) {
-        printf("Error opening pipe!\n");
-        return -1;
-    }
-
-    // Clear buffer - Otherwise old one is used
-    h_running_info[0] = '\0';
-
-    while (fgets(h_running_info, BUFSIZE, fp) != NULL) {
-        // Do whatever you want here...
-        //printf("%s", h_running_info);
-    }
-
-    if (pclose(fp)) {
-        printf("Command not found or exited with error status\n");
-        return -1;
-    }
-
-    return 0;
-
+static void on_running_line(const gchar* line, gpointer data){
+    // Only the last line is used
+    snprintf(h_running_info, BUFSIZE, "%s", line);
 }
 
+static void on_running_done(gint status, gpointer data){
 
-// Ex:
-// char *a[3];
-//get_h_running_info(a);
-//printf("%s",a[0]);
+    RunningQuery* q=data;
+    char* a[3]={NULL, NULL, NULL};
 
-int get_h_running_info(char* a[3]){
-
-    if(init_get_running()==0){
+    if(status==0){
         char * pch;
         pch = strtok (h_running_info," ");
         int i=0;
@@ -287,37 +266,58 @@ int get_h_running_info(char* a[3]){
             pch = strtok (NULL, " ");
             i++;
         }
-
-        return 0;
+    } else {
+        printf("Command not found or exited with error status\n");
     }
 
-    return 1;
+    q->done(a,q->data);
+    g_free(q);
 }
 
+// Ex:
+// get_h_running_info(show_info, NULL);
+// show_info gets {pid, iface, "(wifi_iface)"}, NULL entries if not running.
 
-static int init_get_interface_list(){
-    const char* cmd="echo $( ls /sys/class/net ) ";
+AsyncCmd* get_h_running_info(RunningInfoFunc done, gpointer data){
 
-    FILE *fp;
-    char temp_buff[1024];
+    const gchar* argv[]={HELPER_LIST_RUNNING, NULL};
+    RunningQuery* q=g_new0(RunningQuery,1);
 
-    if ((fp = popen(cmd, "r")) == NULL) {
-        printf("Error opening pipe!\n");
-        return -1;
-    }
+    q->done=done;
+    q->data=data;
 
-    while (fgets(temp_buff, sizeof(temp_buff), fp) != NULL) {
+    // Clear buffer - Otherwise old one is used
+    h_running_info[0] = '\0';
 
-        strcat(interface_list,temp_buff);
-    }
+    return async_cmd_run(argv,CMD_TIMEOUT,on_running_line,on_running_done,q);
+}
 
-    if (pclose(fp)) {
-        printf("Command not found or exited with error status\n");
-        return -1;
+
+static char** build_iface_name_list(char ***arr, int *length, int wifi_only){
+
+    int n = iface_list_count();
+    int i;
+
+    if (*arr != NULL) {
+        for (i = 0; (*arr)[i] != NULL; i++)
+            free((*arr)[i]);
+        free(*arr);
     }
 
+    *arr = malloc((n + 1) * sizeof(char*));
+    if (*arr == NULL)
+        return NULL;
 
-    return 0;
+    *length = 0;
+    for (i = 0; i < n; i++) {
+        const IfaceInfo *info = iface_list_get(i);
+        if (wifi_only && !info->is_wifi)
+            continue;
+        (*arr)[(*length)++] = strdup(info->name);
+    }
+    (*arr)[*length] = NULL;
+
+    return *arr;
 }
 
 //int i=0;
@@ -326,199 +326,244 @@ static int init_get_interface_list(){
 //for(int j=0;j<i;j++){
 //printf("%s ",a[j]);
 //}
+//
+// Returned array is owned here and is valid until the next call.
 
 char** get_interface_list(int *length){
 
-    if(init_get_interface_list()==0){
+    static char** arr;
 
-        char *a=strdup(interface_list);
-        char *b=strdup(interface_list);
+    if (iface_list_count() == 0 && iface_list_refresh() != 0)
+        return NULL;
 
-        char * pch;
-        pch = strtok (a," ");
-        int i=0;
-        while (pch != NULL)
-        {
-            pch = strtok (NULL, " ");
-            i++;
-        }
+    return build_iface_name_list(&arr, length, 0);
+}
 
-        static char** arr;
-        arr =malloc(i * sizeof(char*));
+char** get_wifi_interface_list(int *length){
 
-        free(a);
+    static char** arr;
 
-        pch = strtok (b," ");
-        i=0;
-        while (pch != NULL)
-        {
-            arr[i]=strdup(pch);
-            pch = strtok (NULL, " \n");
-            i++;
-        }
+    if (iface_list_count() == 0 && iface_list_refresh() != 0)
+        return NULL;
 
-        *length= i;
+    return build_iface_name_list(&arr, length, 1);
+}
 
-        return arr;
+static int read_first_line(const char* path, char* buf, size_t size){
 
-    }
+    FILE *fp = fopen(path, "r");
 
-    return NULL;
+    if (fp == NULL)
+        return -1;
 
+    if (fgets(buf, (int) size, fp) == NULL) {
+        fclose(fp);
+        return -1;
+    }
+    buf[strcspn(buf, "\n")] = '\0';
+
+    fclose(fp);
+    return 0;
 }
 
+/**
+ * Look the instance up in the registry of create_ap, one record per pid:
+ * "<pid> <start time> <iface> <wifi iface> <confdir>".
+ */
+static int read_registry(const char* pid, char* confdir, size_t size, char* iface, size_t iface_size){
 
-static int init_get_wifi_interface_list(){
-    const char* cmd="iw dev | awk '$1==\"Interface\"{print $2}' ";
+    char path[PATH_MAX];
+    char line[PATH_MAX + 128];
+    char *fields[5], *save = NULL;
+    int n = 0;
 
-    FILE *fp;
+    snprintf(path, sizeof(path), "%s/%s", CREATE_AP_REGISTRY_PID, pid);
+    if (strchr(pid, '/') != NULL || read_first_line(path, line, sizeof(line)) < 0)
+        return -1;
 
-    char temp_buff[1048];
+    for (char *t = strtok_r(line, " ", &save); t != NULL && n < 5; t = strtok_r(NULL, " ", &save))
+        fields[n++] = t;
 
-    if ((fp = popen(cmd, "r")) == NULL) {
-        printf("Error opening pipe!\n");
+    if (n != 5 || strcmp(fields[0], pid) != 0
+        || strlen(fields[3]) >= iface_size || strlen(fields[4]) >= size)
         return -1;
-    }
 
+    strcpy(iface, fields[3]);
+    strcpy(confdir, fields[4]);
+    return 0;
+}
 
-    while (fgets(temp_buff, sizeof(temp_buff), fp) != NULL) {
+/**
+ * Find the create_ap config directory of the instance with the given pid,
+ * same as get_confdir_from_pid in create_ap. iface receives the wifi
+ * interface the instance runs on. Instances of a create_ap without the
+ * registry are searched for in /tmp.
+ */
+int get_instance_confdir(const char* pid, char* confdir, size_t size, char* iface, size_t iface_size){
 
-        strcat(wifi_interface_list,temp_buff);
-    }
+    char path[PATH_MAX];
+    char buf[64];
+    glob_t g;
+    int found = -1;
 
-    if (pclose(fp)) {
-        printf("Command not found or exited with error status\n");
+    if (pid == NULL)
         return -1;
-    }
 
+    if (read_registry(pid, confdir, size, iface, iface_size) == 0)
+        return 0;
 
-    return 0;
-}
+    if (glob(CREATE_AP_CONFDIR_GLOB, GLOB_ONLYDIR, NULL, &g) != 0)
+        return -1;
 
-char** get_wifi_interface_list(int *length){
+    for (size_t i = 0; i < g.gl_pathc && found < 0; i++) {
+        snprintf(path, sizeof(path), "%s/pid", g.gl_pathv[i]);
+        if (read_first_line(path, buf, sizeof(buf)) < 0 || strcmp(buf, pid) != 0)
+            continue;
 
-    if(init_get_wifi_interface_list()==0){
+        snprintf(path, sizeof(path), "%s/wifi_iface", g.gl_pathv[i]);
+        if (read_first_line(path, iface, iface_size) < 0)
+            continue;
 
-        char *a=strdup(wifi_interface_list);
-        char *b=strdup(wifi_interface_list);
+        snprintf(confdir, size, "%s", g.gl_pathv[i]);
+        found = 0;
+    }
 
-        char * pch;
-        pch = strtok (a,"\n");
-        int i=0;
-        while (pch != NULL)
-        {
-            pch = strtok (NULL, "\n");
-            i++;
-        }
+    globfree(&g);
+    return found;
+}
 
-        static char** arr;
-        arr =malloc(i * sizeof(char*));
+/**
+ * Follow the station events of the hostapd of instance pid through the
+ * helper. on_line gets them as hostapd sends them, see hostapd_event_parse().
+ * Returns NULL if the instance has no config directory yet.
+ */
+AsyncCmd* follow_station_events(const char* pid, AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer data){
 
-        free(a);
+    char confdir[PATH_MAX];
+    char iface[IF_NAMESIZE];
 
-        pch = strtok (b,"\n");
-        i=0;
-        while (pch != NULL)
-        {
+    if (get_instance_confdir(pid, confdir, sizeof(confdir), iface, sizeof(iface)) != 0)
+        return NULL;
 
-            arr[i]=strdup(pch);
-            pch = strtok (NULL, "\n");
-            i++;
-        }
+    const gchar* argv[]={HELPER_STATION_EVENTS, confdir, iface, NULL};
 
-        *length= i;
+    return async_cmd_run(argv,0,on_line,on_done,data);
+}
 
-        return arr;
+/**
+ * Add a sample for the interfaces of the instance and for its clients.
+ */
+static void sample_traffic(TrafficMonitor *traffic, const char *confdir, const char *iface)
+{
+    char path[PATH_MAX];
+    char uplink[IF_NAMESIZE];
+    gint64 now = g_get_monotonic_time();
 
-    }
+    snprintf(path, sizeof(path), "%s/nat_internet_iface", confdir);
+    if (read_first_line(path, uplink, sizeof(uplink)) < 0)
+        uplink[0] = '\0';
 
-    return NULL;
+    traffic_monitor_sample_iface(traffic, TRAFFIC_IFACE_AP, iface, now);
+    traffic_monitor_sample_iface(traffic, TRAFFIC_IFACE_UPLINK, uplink, now);
 
+    traffic_monitor_begin(traffic);
+    for (int i = 0; i < station_count(); i++) {
+        const StationInfo *st = station_get(i);
+        traffic_monitor_sample_client(traffic, st->mac, st->rx_bytes, st->tx_bytes, now);
+    }
+    traffic_monitor_end(traffic);
 }
 
-char* generate_qr_image(char* ssid,char* type,char *password){
-    char cmd[BUFSIZE];
+static ClientTable *clients;
+static LeaseTracker *leases;
 
-    qr_image_path = "/tmp/wihotspot_qr.png";
+/**
+ * Follow the dnsmasq leases of the instance in confdir.
+ */
+static void track_leases(const char *confdir)
+{
+    // A new instance has its own config directory
+    if (leases != NULL && strcmp(lease_tracker_confdir(leases), confdir) != 0) {
+        lease_tracker_free(leases);
+        leases = NULL;
+    }
 
-    // snprintf(cmd, BUFSIZE, "%s -s 10 -d 256 -o %s 'WIFI:S:%s;T:%s;P:%s;;' ","qrencode",qr_image_path, ssid,type,password);
+    if (leases == NULL)
+        leases = lease_tracker_new(confdir);
+    else
+        lease_tracker_dispatch(leases);
+}
 
-    // FILE *fp;
+static void update_client(const StationInfo *st)
+{
+    const LeaseInfo *lease = leases != NULL ? lease_tracker_lookup(leases, st->mac) : NULL;
 
-    // char temp_buff[1048];
+    client_table_update(clients, st);
+    client_table_set_lease(clients, st->mac, lease != NULL ? lease->ipv4 : 0,
+                           lease != NULL ? lease->hostname : NULL);
+}
 
-    // if ((fp = popen(cmd, "r")) == NULL) {
-    //     printf("Error opening pipe!\n");
-        
-    // }
+/**
+ * Refresh the client table of the instance with the given pid. The table
+ * is owned here; rows that did not change keep their state.
+ * If traffic is not NULL, the same station dump is sampled into it.
+ */
+const ClientTable* get_connected_devices(const char *PID, TrafficMonitor *traffic)
+{
+    char confdir[PATH_MAX];
+    char iface[IF_NAMESIZE];
+
+    if (clients == NULL && (clients = client_table_new()) == NULL)
+        return NULL;
 
+    client_table_begin(clients);
 
-    // while (fgets(temp_buff, sizeof(temp_buff), fp) != NULL) {
-    
-    //     printf("%s", temp_buff);
-    // }
+    if (get_instance_confdir(PID, confdir, sizeof(confdir), iface, sizeof(iface)) == 0
+        && station_dump(iface) == 0) {
 
-    // if (pclose(fp)) {
-    //     printf("Error executing qrencode\n");
-        
-    // }
+        track_leases(confdir);
+        for (int i = 0; i < station_count(); i++)
+            update_client(station_get(i));
 
-    snprintf(cmd, BUFSIZE, "WIFI:S:%s;T:%s;P:%s;;",ssid,type,password);
+        if (traffic != NULL)
+            sample_traffic(traffic, confdir, iface);
+    }
 
-    qr_to_png(cmd,qr_image_path);
-    
-    return qr_image_path;
+    client_table_end(clients);
+    return clients;
 }
 
-Node get_connected_devices(char *PID)
+/**
+ * Refresh only the client with the given mac, e.g. when hostapd reports
+ * that it joined. Its row is removed if it is not associated any more.
+ */
+const ClientTable* get_connected_device(const char *PID, const unsigned char *mac)
 {
-    char cmd[BUFSIZE];
-    snprintf(cmd, BUFSIZE, "%s %s --list-clients %s", SUDO, CREATE_AP, PID);
-    FILE *fp;
-    Node l = (struct Device *)malloc(sizeof(struct Device));
-    Position head = l;
-    fp = popen(cmd, "r");
-    char line[BUFSIZE];
-
-    int _n = 0; //Device number
-    while (fgets(line, BUFSIZE, fp) != NULL)
-    {
-        if (strstr(line, "MAC") != NULL)
-            continue;
+    char confdir[PATH_MAX];
+    char iface[IF_NAMESIZE];
+    StationInfo st;
 
-        _n++;
-        int size = strlen(line);
-        int marker[3] = {0};
-        int n = 0;             // For marker
-        line[size - 1] = '\0'; // Remove "\n"
-        for (int i = 0; i < size; i++)
-        {
-            if (*(line + i) != ' ' && *(line + i + 1) == ' ')
-            {
-                // End
-                *(line + i + 1) = '\0';
-                i++;
-            }
-            if (*(line + i) == ' ' && *(line + i + 1) != ' ')
-            {
-                // Head
-                *(line + i) = '\0';
-                marker[++n] = i + 1;
-            }
-        }
-        l = add_device_node(l, _n, line, marker);
+    if (clients == NULL && (clients = client_table_new()) == NULL)
+        return NULL;
+
+    if (get_instance_confdir(PID, confdir, sizeof(confdir), iface, sizeof(iface)) == 0
+        && station_query(iface, mac, &st) == 0) {
+        track_leases(confdir);
+        update_client(&st);
+    }
+    else {
+        client_table_remove(clients, mac);
     }
-    return head;
+
+    return clients;
 }
 
-PtrToNode add_device_node(PtrToNode l, int number, char line[BUFSIZE], int marker[3])
+/**
+ * Drop the client with the given mac, e.g. when hostapd reports that it
+ * left.
+ */
+void forget_connected_device(const unsigned char *mac)
 {
-    Node next = (PtrToNode)malloc(sizeof(struct Device));
-    strcpy(next->MAC, line);
-    strcpy(next->IP, line + marker[1]);
-    strcpy(next->HOSTNAME, line + marker[2]);
-    next->Number = number;
-    next->Next = NULL;
-    l->Next = next;
-    return next;
+    if (clients != NULL)
+        client_table_remove(clients, mac);
 }
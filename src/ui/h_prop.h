@@ -34,46 +34,40 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "read_config.h"
+#include <stddef.h>
 
-typedef struct Device *PtrToNode;
-struct Device
-{
-        char HOSTNAME[2048];
-        char IP[2048];
-        char MAC[2048];
-        unsigned int Number;
-        PtrToNode Next;
-}; // Head node is null
-typedef PtrToNode Position;
-typedef PtrToNode Node;
+#include "async_cmd.h"
+#include "client_table.h"
+#include "traffic.h"
 
-static int parse_output(const char *);
 
-const char *build_wh_start_command(char *, char *, char *, char *);
-const char *build_wh_from_config(void);
+typedef void (*RunningInfoFunc)(char* a[3], gpointer data);
 
-int startShell(const char *);
+void write_hotspot_config(ConfigValues* cv, AsyncCmdDoneFunc done, gpointer data);
 
-int write_config(char *);
+AsyncCmd* start_hotspot(const char* freq, AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer data);
 
-int get_h_running_info(char** a);
-static int init_get_running();
+AsyncCmd* reload_hotspot(const char* pid, const char* freq, AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer data);
 
-static int init_get_interface_list();
-char** get_interface_list(int*);
-const char* build_kill_create_ap_command(char* pid);
+AsyncCmd* stop_hotspot(const char* pid, AsyncCmdDoneFunc on_done, gpointer data);
+
+int write_config(char *);
 
-const char *build_wh_mkconfig_command(ConfigValues* cv);
+AsyncCmd* get_h_running_info(RunningInfoFunc done, gpointer data);
 
+char** get_interface_list(int*);
 char** get_wifi_interface_list(int *length);
 
-void write_accepted_macs(char* filename, char* accepted_macs);
+AsyncCmd* write_accepted_macs(char* filename, char* accepted_macs, AsyncCmdDoneFunc on_done, gpointer data);
 
 char * read_mac_filter_file(char * filename);
 
-char* generate_qr_image(char* ssid,char* type,char *password);
+int get_instance_confdir(const char* pid, char* confdir, size_t size, char* iface, size_t iface_size);
+
+AsyncCmd* follow_station_events(const char* pid, AsyncCmdLineFunc on_line, AsyncCmdDoneFunc on_done, gpointer data);
 
-Node get_connected_devices(char *PID);
-PtrToNode add_device_node(Node l, int number, char *line, int marker[3]);
+const ClientTable* get_connected_devices(const char *PID, TrafficMonitor *traffic);
+const ClientTable* get_connected_device(const char *PID, const unsigned char *mac);
+void forget_connected_device(const unsigned char *mac);
 
 #endif //WIHOTSPOT_H_PROP_H
@@ -0,0 +1,233 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "hostapd_ctrl.h"
+
+#define CTRL_DIR_NAME "hostapd_ctrl"
+#define REPLY_TIMEOUT_MS 1000
+#define MSG_MAX_LEN 4096
+#define EVENT_MAX_LEN 256
+
+struct HostapdCtrl {
+    int fd;
+};
+
+static const struct {
+    const char *name;
+    HostapdEventType type;
+} EVENTS[] = {
+    {"AP-STA-CONNECTED", HOSTAPD_EVENT_STA_CONNECTED},
+    {"AP-STA-DISCONNECTED", HOSTAPD_EVENT_STA_DISCONNECTED},
+    {"EAPOL-4WAY-HS-COMPLETED", HOSTAPD_EVENT_HANDSHAKE_DONE},
+};
+
+/**
+ * Send a command and wait for its reply, skipping any events that arrive
+ * first. Returns 0 if hostapd answered OK.
+ */
+static int request(int fd, const char *cmd){
+
+    char reply[MSG_MAX_LEN];
+    struct pollfd pfd = {fd, POLLIN, 0};
+    ssize_t n;
+
+    if (send(fd, cmd, strlen(cmd), 0) < 0)
+        return -1;
+
+    for (;;) {
+        int r = poll(&pfd, 1, REPLY_TIMEOUT_MS);
+
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0) {
+            if (r == 0)
+                errno = ETIMEDOUT;
+            return -1;
+        }
+
+        n = recv(fd, reply, sizeof(reply), 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (n > 0 && reply[0] == '<')
+            continue;
+
+        if (n < 2 || memcmp(reply, "OK", 2) != 0) {
+            errno = EPROTO;
+            return -1;
+        }
+        return 0;
+    }
+}
+
+HostapdCtrl *hostapd_ctrl_open(const char *confdir, const char *iface){
+
+    struct sockaddr_un local = {.sun_family = AF_UNIX};
+    struct sockaddr_un remote = {.sun_family = AF_UNIX};
+    HostapdCtrl *c;
+    int fd, len;
+
+    len = snprintf(remote.sun_path, sizeof(remote.sun_path), "%s/" CTRL_DIR_NAME "/%s", confdir, iface);
+    if (len < 0 || len >= (int) sizeof(remote.sun_path)) {
+        errno = ENAMETOOLONG;
+        return NULL;
+    }
+
+    fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return NULL;
+
+    // Binding only the family picks a free abstract address, so hostapd has
+    // somewhere to send to and nothing is left behind in the file system
+    if (bind(fd, (struct sockaddr *) &local, sizeof(sa_family_t)) < 0
+        || connect(fd, (struct sockaddr *) &remote, sizeof(remote)) < 0
+        || request(fd, "ATTACH") < 0
+        || fcntl(fd, F_SETFL, O_NONBLOCK) < 0)
+        goto fail;
+
+    c = malloc(sizeof(HostapdCtrl));
+    if (c == NULL)
+        goto fail;
+
+    c->fd = fd;
+    return c;
+
+fail:
+    {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+    }
+    return NULL;
+}
+
+void hostapd_ctrl_close(HostapdCtrl *c){
+
+    if (c == NULL)
+        return;
+
+    // Best effort, hostapd also drops monitors it can no longer reach
+    send(c->fd, "DETACH", 6, MSG_DONTWAIT);
+    close(c->fd);
+    free(c);
+}
+
+int hostapd_ctrl_fd(const HostapdCtrl *c){
+
+    return c != NULL ? c->fd : -1;
+}
+
+int hostapd_ctrl_dispatch(HostapdCtrl *c, HostapdEvent *events, int max){
+
+    char msg[MSG_MAX_LEN];
+    int count = 0;
+
+    // Anything left once max is reached keeps the socket readable
+    while (count < max) {
+        ssize_t n = recv(c->fd, msg, sizeof(msg), 0);
+
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return -1;
+        }
+
+        if (hostapd_event_parse(msg, (size_t) n, &events[count]) == 0)
+            count++;
+    }
+
+    return count;
+}
+
+static int parse_mac(const char *s, unsigned char *mac){
+
+    unsigned int b[6];
+    int n = 0;
+
+    if (sscanf(s, "%2x:%2x:%2x:%2x:%2x:%2x%n", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &n) != 6
+        || n != 17 || (s[n] != '\0' && s[n] != ' ' && s[n] != '\n'))
+        return -1;
+
+    for (int i = 0; i < 6; i++)
+        mac[i] = (unsigned char) b[i];
+    return 0;
+}
+
+int hostapd_event_parse(const char *msg, size_t len, HostapdEvent *event){
+
+    char line[EVENT_MAX_LEN];
+    const char *s;
+
+    // Events are "<level>NAME args", with an IFNAME= prefix on the global socket
+    if (len < 3 || msg[0] != '<')
+        return -1;
+
+    if (len >= sizeof(line))
+        len = sizeof(line) - 1;
+    memcpy(line, msg, len);
+    line[len] = '\0';
+
+    s = strchr(line, '>');
+    if (s == NULL)
+        return -1;
+    s++;
+
+    if (strncmp(s, "IFNAME=", 7) == 0) {
+        s = strchr(s, ' ');
+        if (s == NULL)
+            return -1;
+        s++;
+    }
+
+    for (size_t i = 0; i < sizeof(EVENTS) / sizeof(EVENTS[0]); i++) {
+        size_t n = strlen(EVENTS[i].name);
+
+        if (strncmp(s, EVENTS[i].name, n) == 0 && s[n] == ' ') {
+            if (parse_mac(s + n + 1, event->mac) < 0)
+                return -1;
+            event->type = EVENTS[i].type;
+            return 0;
+        }
+    }
+
+    return -1;
+}
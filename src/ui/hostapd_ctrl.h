@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_HOSTAPD_CTRL_H
+#define WIHOTSPOT_HOSTAPD_CTRL_H
+
+#include <stddef.h>
+
+/*
+ * Station events of a running hostapd, read from its control socket.
+ *
+ * create_ap starts hostapd with ctrl_interface=<confdir>/hostapd_ctrl,
+ * which only root can reach. wihotspot-helper connects and relays the
+ * events to the GUI. The client sends ATTACH once, after which hostapd
+ * pushes an unsolicited message for every station that joins, leaves or
+ * finishes the 4-way handshake.
+ */
+
+typedef enum {
+    HOSTAPD_EVENT_NONE,
+    HOSTAPD_EVENT_STA_CONNECTED,
+    HOSTAPD_EVENT_STA_DISCONNECTED,
+    HOSTAPD_EVENT_HANDSHAKE_DONE
+} HostapdEventType;
+
+typedef struct {
+    HostapdEventType type;
+    unsigned char mac[6];
+} HostapdEvent;
+
+typedef struct HostapdCtrl HostapdCtrl;
+
+/**
+ * Connect to the control socket of iface under confdir and attach to its
+ * events. Returns NULL with errno set if hostapd is not reachable.
+ */
+HostapdCtrl *hostapd_ctrl_open(const char *confdir, const char *iface);
+void hostapd_ctrl_close(HostapdCtrl *c);
+
+int hostapd_ctrl_fd(const HostapdCtrl *c);
+
+/**
+ * Read the pending messages without blocking and store up to max station
+ * events. Returns their number, or -1 if the connection was lost.
+ */
+int hostapd_ctrl_dispatch(HostapdCtrl *c, HostapdEvent *events, int max);
+
+/** Parse one event message. Returns 0, or -1 if it is not a station event. */
+int hostapd_event_parse(const char *msg, size_t len, HostapdEvent *event);
+
+#endif //WIHOTSPOT_HOSTAPD_CTRL_H
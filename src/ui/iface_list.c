@@ -0,0 +1,311 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <linux/rtnetlink.h>
+#include <linux/nl80211.h>
+
+#include "netlink.h"
+#include "iface_list.h"
+
+static IfaceInfo *ifaces;
+static int iface_count;
+static int iface_cap;
+
+static int rtnl_fd = -1;
+static int genl_fd = -1;
+static int nl80211_id = -1;
+static int monitor_fd = -1;
+
+static int compare_iface(const void *a, const void *b){
+    return strcmp(((const IfaceInfo *) a)->name, ((const IfaceInfo *) b)->name);
+}
+
+static IfaceInfo *find_by_index(int index){
+
+    for (int i = 0; i < iface_count; i++) {
+        if (ifaces[i].index == index)
+            return &ifaces[i];
+    }
+    return NULL;
+}
+
+static IfaceInfo *add_iface(int index){
+
+    IfaceInfo *info;
+
+    if (iface_count == iface_cap) {
+        int cap = iface_cap ? iface_cap * 2 : 16;
+        IfaceInfo *n = realloc(ifaces, cap * sizeof(IfaceInfo));
+        if (n == NULL)
+            return NULL;
+        ifaces = n;
+        iface_cap = cap;
+    }
+
+    info = &ifaces[iface_count++];
+    memset(info, 0, sizeof(IfaceInfo));
+    info->index = index;
+    info->wiphy = -1;
+    return info;
+}
+
+static void remove_iface(int index){
+
+    IfaceInfo *info = find_by_index(index);
+
+    if (info == NULL)
+        return;
+
+    iface_count--;
+    memmove(info, info + 1, (char *) (ifaces + iface_count) - (char *) info);
+}
+
+/**
+ * Apply one RTM_NEWLINK/RTM_DELLINK message to the table.
+ * Returns 1 if the set of interface names changed.
+ */
+static int apply_link_msg(struct nlmsghdr *nlh){
+
+    struct ifinfomsg *ifi = NLMSG_DATA(nlh);
+    struct nlattr *tb[IFLA_MAX + 1];
+    IfaceInfo *info;
+
+    if (nlh->nlmsg_type == RTM_DELLINK) {
+        if (find_by_index(ifi->ifi_index) == NULL)
+            return 0;
+        remove_iface(ifi->ifi_index);
+        return 1;
+    }
+
+    if (nlh->nlmsg_type != RTM_NEWLINK)
+        return 0;
+
+    netlink_parse_attrs(tb, IFLA_MAX, IFLA_RTA(ifi), nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*ifi)));
+
+    if (tb[IFLA_IFNAME] == NULL)
+        return 0;
+
+    info = find_by_index(ifi->ifi_index);
+
+    if (info != NULL) {
+        info->flags = ifi->ifi_flags;
+        if (strncmp(info->name, netlink_attr_data(tb[IFLA_IFNAME]), IF_NAMESIZE) == 0)
+            return 0;
+    } else if ((info = add_iface(ifi->ifi_index)) == NULL) {
+        return 0;
+    }
+
+    info->flags = ifi->ifi_flags;
+    strncpy(info->name, netlink_attr_data(tb[IFLA_IFNAME]), IF_NAMESIZE - 1);
+    info->name[IF_NAMESIZE - 1] = '\0';
+    return 1;
+}
+
+static int link_dump_cb(struct nlmsghdr *nlh, void *arg){
+    apply_link_msg(nlh);
+    return 0;
+}
+
+static int wifi_dump_cb(struct nlmsghdr *nlh, void *arg){
+
+    struct nlattr *tb[NL80211_ATTR_MAX + 1];
+    IfaceInfo *info;
+    int len;
+    void *attrs = genl_msg_attrs(nlh, &len);
+
+    netlink_parse_attrs(tb, NL80211_ATTR_MAX, attrs, len);
+
+    if (tb[NL80211_ATTR_IFINDEX] == NULL)
+        return 0;
+
+    info = find_by_index(netlink_attr_u32(tb[NL80211_ATTR_IFINDEX]));
+    if (info == NULL)
+        return 0;
+
+    info->is_wifi = 1;
+    if (tb[NL80211_ATTR_WIPHY])
+        info->wiphy = netlink_attr_u32(tb[NL80211_ATTR_WIPHY]);
+    if (tb[NL80211_ATTR_IFTYPE])
+        info->iftype = netlink_attr_u32(tb[NL80211_ATTR_IFTYPE]);
+    if (tb[NL80211_ATTR_SSID]) {
+        int n = netlink_attr_len(tb[NL80211_ATTR_SSID]);
+
+        if (n > (int) sizeof(info->ssid) - 1)
+            n = sizeof(info->ssid) - 1;
+        memcpy(info->ssid, netlink_attr_data(tb[NL80211_ATTR_SSID]), n);
+        info->ssid[n] = '\0';
+    }
+
+    return 0;
+}
+
+static int load_links(void){
+
+    char buf[128];
+    struct nlmsghdr *nlh = (struct nlmsghdr *) buf;
+    struct ifinfomsg ifi;
+
+    if (rtnl_fd < 0 && (rtnl_fd = netlink_open(NETLINK_ROUTE)) < 0)
+        return -1;
+
+    memset(&ifi, 0, sizeof(ifi));
+    ifi.ifi_family = AF_UNSPEC;
+
+    netlink_msg_init(nlh, RTM_GETLINK, NLM_F_DUMP);
+    netlink_msg_put(nlh, sizeof(buf), &ifi, sizeof(ifi));
+
+    return netlink_request(rtnl_fd, nlh, link_dump_cb, NULL);
+}
+
+/**
+ * Mark wireless interfaces. Failing here is not fatal: a machine
+ * without any cfg80211 driver simply has no nl80211 family.
+ */
+static void load_wifi(void){
+
+    char buf[64];
+    struct nlmsghdr *nlh = (struct nlmsghdr *) buf;
+
+    for (int i = 0; i < iface_count; i++) {
+        ifaces[i].is_wifi = 0;
+        ifaces[i].wiphy = -1;
+        ifaces[i].ssid[0] = '\0';
+    }
+
+    if (genl_fd < 0 && (genl_fd = netlink_open(NETLINK_GENERIC)) < 0)
+        return;
+
+    if (nl80211_id < 0 && (nl80211_id = genl_family_id(genl_fd, NL80211_GENL_NAME)) < 0)
+        return;
+
+    genl_msg_init(nlh, nl80211_id, NL80211_CMD_GET_INTERFACE, NLM_F_DUMP);
+    netlink_request(genl_fd, nlh, wifi_dump_cb, NULL);
+}
+
+int iface_list_refresh(void){
+
+    iface_count = 0;
+
+    if (load_links() < 0)
+        return -1;
+
+    load_wifi();
+    qsort(ifaces, iface_count, sizeof(IfaceInfo), compare_iface);
+
+    return 0;
+}
+
+int iface_list_count(void){
+    return iface_count;
+}
+
+const IfaceInfo *iface_list_get(int i){
+
+    if (i < 0 || i >= iface_count)
+        return NULL;
+
+    return &ifaces[i];
+}
+
+const IfaceInfo *iface_list_find(const char *name){
+
+    for (int i = 0; i < iface_count; i++) {
+        if (strcmp(ifaces[i].name, name) == 0)
+            return &ifaces[i];
+    }
+    return NULL;
+}
+
+/**
+ * Socket subscribed to RTNLGRP_LINK. Poll it for input and call
+ * iface_monitor_dispatch() when it becomes readable.
+ */
+int iface_monitor_fd(void){
+
+    if (monitor_fd >= 0)
+        return monitor_fd;
+
+    if ((monitor_fd = netlink_open(NETLINK_ROUTE)) < 0)
+        return -1;
+
+    if (netlink_add_membership(monitor_fd, RTNLGRP_LINK) < 0) {
+        close(monitor_fd);
+        monitor_fd = -1;
+        return -1;
+    }
+
+    fcntl(monitor_fd, F_SETFL, fcntl(monitor_fd, F_GETFL) | O_NONBLOCK);
+
+    return monitor_fd;
+}
+
+static int monitor_cb(struct nlmsghdr *nlh, void *arg){
+    *(int *) arg |= apply_link_msg(nlh);
+    return 0;
+}
+
+/**
+ * Apply queued link notifications to the cached table.
+ * Returns 1 if interfaces were added, removed or renamed, 0 otherwise.
+ */
+int iface_monitor_dispatch(void){
+
+    int changed = 0;
+    int r;
+
+    if (monitor_fd < 0)
+        return 0;
+
+    r = netlink_dispatch(monitor_fd, monitor_cb, &changed);
+
+    if (r < 0) {
+        iface_list_refresh();
+        return 1;
+    }
+
+    if (r == 0)
+        return 0;
+
+    if (changed) {
+        // A new netdev may be a freshly created wifi interface
+        load_wifi();
+        qsort(ifaces, iface_count, sizeof(IfaceInfo), compare_iface);
+    }
+
+    return changed;
+}
+
+void iface_monitor_close(void){
+
+    if (monitor_fd >= 0)
+        close(monitor_fd);
+    monitor_fd = -1;
+}
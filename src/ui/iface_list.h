@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_IFACE_LIST_H
+#define WIHOTSPOT_IFACE_LIST_H
+
+#include <net/if.h>
+
+/*
+ * In-process network interface inventory.
+ *
+ * Interfaces are read with a rtnetlink link dump and wireless ones are
+ * marked with an nl80211 interface dump, which also gives the SSID of
+ * every running access point. The table is cached and kept up to
+ * date by feeding RTNLGRP_LINK notifications from iface_monitor_fd() into
+ * iface_monitor_dispatch().
+ */
+
+typedef struct {
+    int index;
+    char name[IF_NAMESIZE];
+    unsigned int flags;     // IFF_* flags of the link
+    int is_wifi;
+    int wiphy;              // -1 if not a wifi interface
+    unsigned int iftype;    // NL80211_IFTYPE_* of a wifi interface
+    char ssid[33];          // SSID of an access point, "" otherwise
+} IfaceInfo;
+
+int iface_list_refresh(void);
+int iface_list_count(void);
+const IfaceInfo *iface_list_get(int i);
+const IfaceInfo *iface_list_find(const char *name);
+
+int iface_monitor_fd(void);
+int iface_monitor_dispatch(void);
+void iface_monitor_close(void);
+
+#endif //WIHOTSPOT_IFACE_LIST_H
@@ -0,0 +1,222 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "instance_status.h"
+#include "instance_watch.h"
+#include "iface_list.h"
+#include "station.h"
+#include "util.h"
+
+static InstanceStatus *statuses;
+static int status_count;
+static int status_cap;
+
+static int64_t monotonic_us(void){
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Seconds since boot, as the start time in /proc/<pid>/stat is.
+ */
+static double boot_uptime(void){
+
+    FILE *fp = fopen("/proc/uptime", "r");
+    double uptime = -1;
+
+    if (fp == NULL)
+        return -1;
+    if (fscanf(fp, "%lf", &uptime) != 1)
+        uptime = -1;
+    fclose(fp);
+    return uptime;
+}
+
+static long process_uptime(pid_t pid, double now){
+
+    char path[32];
+    char stat[1024];
+    unsigned long long ticks;
+    long hz = sysconf(_SC_CLK_TCK);
+    FILE *fp;
+    size_t n;
+
+    if (now < 0 || hz <= 0)
+        return -1;
+
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int) pid);
+    if ((fp = fopen(path, "r")) == NULL)
+        return -1;
+    n = fread(stat, 1, sizeof(stat) - 1, fp);
+    fclose(fp);
+    stat[n] = '\0';
+
+    if (proc_stat_starttime(stat, &ticks) < 0)
+        return -1;
+
+    now -= (double) ticks / hz;
+    return now > 0 ? (long) now : 0;
+}
+
+static void update_status(InstanceStatus *s, const InstanceInfo *inst, double now, int64_t sample_time){
+
+    const IfaceInfo *info;
+
+    snprintf(s->iface, sizeof(s->iface), "%s", inst->iface);
+
+    info = iface_list_find(s->iface);
+    snprintf(s->ssid, sizeof(s->ssid), "%s", info != NULL ? info->ssid : "");
+
+    s->clients = station_dump(s->iface) == 0 ? station_count() : -1;
+    s->uptime = process_uptime(s->pid, now);
+
+    if (s->traffic != NULL)
+        traffic_monitor_sample_iface(s->traffic, TRAFFIC_IFACE_AP, s->iface, sample_time);
+}
+
+static int find_status(pid_t pid, int from){
+
+    for (int i = from; i < status_count; i++) {
+        if (statuses[i].pid == pid)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * Make room for the status of pid at position i, reusing its old entry so
+ * that its traffic history is kept.
+ */
+static InstanceStatus *place_status(pid_t pid, int i){
+
+    int j = find_status(pid, i);
+
+    if (j >= 0) {
+        InstanceStatus tmp = statuses[j];
+        statuses[j] = statuses[i];
+        statuses[i] = tmp;
+        return &statuses[i];
+    }
+
+    if (status_count == status_cap) {
+        int cap = status_cap ? status_cap * 2 : 4;
+        InstanceStatus *n = realloc(statuses, cap * sizeof(InstanceStatus));
+        if (n == NULL)
+            return NULL;
+        statuses = n;
+        status_cap = cap;
+    }
+
+    memmove(&statuses[i + 1], &statuses[i], (status_count - i) * sizeof(InstanceStatus));
+    status_count++;
+
+    memset(&statuses[i], 0, sizeof(InstanceStatus));
+    statuses[i].pid = pid;
+    statuses[i].traffic = traffic_monitor_new();
+    return &statuses[i];
+}
+
+static void truncate_statuses(int n){
+
+    while (status_count > n)
+        traffic_monitor_free(statuses[--status_count].traffic);
+}
+
+/**
+ * Statuses follow the order of instance_watch, stopped instances are
+ * dropped.
+ */
+int instance_status_refresh(void){
+
+    double now = boot_uptime();
+    int64_t sample_time = monotonic_us();
+    int n = 0;
+
+    iface_list_refresh();
+
+    for (int i = 0; i < instance_watch_count(); i++) {
+        const InstanceInfo *inst = instance_watch_get(i);
+        InstanceStatus *s;
+
+        if (!inst->running || (s = place_status(inst->pid, n)) == NULL)
+            continue;
+
+        update_status(s, inst, now, sample_time);
+        n++;
+    }
+
+    truncate_statuses(n);
+    return n;
+}
+
+int instance_status_refresh_one(pid_t pid){
+
+    int i = find_status(pid, 0);
+
+    for (int j = 0; i >= 0 && j < instance_watch_count(); j++) {
+        const InstanceInfo *inst = instance_watch_get(j);
+
+        if (inst->running && inst->pid == pid) {
+            iface_list_refresh();
+            update_status(&statuses[i], inst, boot_uptime(), monotonic_us());
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int instance_status_count(void){
+    return status_count;
+}
+
+const InstanceStatus *instance_status_get(int i){
+
+    if (i < 0 || i >= status_count)
+        return NULL;
+
+    return &statuses[i];
+}
+
+const InstanceStatus *instance_status_find(pid_t pid){
+
+    int i = find_status(pid, 0);
+
+    return i >= 0 ? &statuses[i] : NULL;
+}
+
+void instance_status_clear(void){
+    truncate_statuses(0);
+}
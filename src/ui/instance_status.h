@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_INSTANCE_STATUS_H
+#define WIHOTSPOT_INSTANCE_STATUS_H
+
+#include <net/if.h>
+#include <sys/types.h>
+
+#include "traffic.h"
+
+/*
+ * Status of every running create_ap instance, for the dashboard.
+ *
+ * The instances come from instance_watch, and all SSIDs from a single
+ * nl80211 interface dump. Clients are counted with one station dump per
+ * access point, and the uptime is the age of the instance process. The
+ * access point counters are sampled on every refresh, so the rate is that
+ * of the refresh interval. Nothing is spawned.
+ */
+
+typedef struct {
+    pid_t pid;
+    char iface[IF_NAMESIZE];
+    char ssid[33];              // "" if unknown
+    int clients;                // -1 if the stations could not be read
+    long uptime;                // s, -1 if unknown
+    TrafficMonitor *traffic;    // TRAFFIC_IFACE_AP is the access point
+} InstanceStatus;
+
+/** Update the status of every running instance. Returns their number. */
+int instance_status_refresh(void);
+
+/** Update only the instance with the given pid. Returns 0, or -1 if it is not running. */
+int instance_status_refresh_one(pid_t pid);
+
+int instance_status_count(void);
+const InstanceStatus *instance_status_get(int i);
+const InstanceStatus *instance_status_find(pid_t pid);
+
+void instance_status_clear(void);
+
+#endif //WIHOTSPOT_INSTANCE_STATUS_H
@@ -0,0 +1,390 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <glob.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/syscall.h>
+
+#include "instance_watch.h"
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+#define TMP_DIR "/tmp"
+#define CONFDIR_PREFIX "create_ap."
+#define CONFDIR_GLOB TMP_DIR "/create_ap.*.conf.*"
+
+#define TMP_EVENTS (IN_CREATE | IN_DELETE | IN_ATTRIB | IN_MOVED_TO | IN_MOVED_FROM | IN_ONLYDIR)
+#define CONFDIR_EVENTS (IN_CREATE | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_TO | IN_DELETE)
+
+static InstanceInfo *instances;
+static int instance_count;
+static int instance_cap;
+
+static int epoll_fd = -1;
+static int inotify_fd = -1;
+static int tmp_wd = -1;
+
+/**
+ * create_ap.<iface>.conf.XXXXXXXX, but not create_ap.common.conf
+ */
+static int is_confdir_name(const char *name){
+
+    const char *conf;
+
+    if (strncmp(name, CONFDIR_PREFIX, strlen(CONFDIR_PREFIX)) != 0)
+        return 0;
+
+    conf = strstr(name + strlen(CONFDIR_PREFIX), ".conf.");
+    return conf != NULL && conf[strlen(".conf.")] != '\0';
+}
+
+static int read_first_line(const char *dir, const char *file, char *buf, size_t size){
+
+    char path[PATH_MAX];
+    FILE *fp;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, file);
+
+    if ((fp = fopen(path, "r")) == NULL)
+        return -1;
+
+    if (fgets(buf, (int) size, fp) == NULL) {
+        fclose(fp);
+        return -1;
+    }
+    buf[strcspn(buf, "\n")] = '\0';
+
+    fclose(fp);
+    return buf[0] != '\0' ? 0 : -1;
+}
+
+static void close_pidfd(InstanceInfo *inst){
+
+    if (inst->pidfd >= 0)
+        close(inst->pidfd);
+    inst->pidfd = -1;
+}
+
+static int pid_alive(pid_t pid){
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+/**
+ * Read pid and wifi_iface of an instance and take a pidfd on it.
+ * Returns 1 if its running state or pid changed.
+ */
+static int load_instance(InstanceInfo *inst){
+
+    char buf[64];
+    pid_t pid = 0;
+    int was_running = inst->running;
+    pid_t old_pid = inst->pid;
+
+    if (inst->wd < 0 && inotify_fd >= 0)
+        inst->wd = inotify_add_watch(inotify_fd, inst->confdir, CONFDIR_EVENTS);
+
+    if (read_first_line(inst->confdir, "pid", buf, sizeof(buf)) == 0)
+        pid = (pid_t) strtol(buf, NULL, 10);
+
+    if (pid <= 0 || read_first_line(inst->confdir, "wifi_iface", inst->iface, sizeof(inst->iface)) < 0) {
+        close_pidfd(inst);
+        inst->running = 0;
+        return was_running;
+    }
+
+    if (pid != inst->pid) {
+        close_pidfd(inst);
+        inst->pid = pid;
+    }
+
+    if (inst->pidfd < 0 && (inst->pidfd = (int) syscall(SYS_pidfd_open, pid, 0)) >= 0) {
+        struct epoll_event ev = {.events = EPOLLIN, .data.fd = inst->pidfd};
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, inst->pidfd, &ev);
+    }
+
+    // A directory left behind by a killed instance has a stale pid
+    inst->running = pid_alive(pid);
+    if (!inst->running)
+        close_pidfd(inst);
+
+    return was_running != inst->running || old_pid != inst->pid;
+}
+
+static InstanceInfo *find_by_confdir(const char *confdir){
+
+    for (int i = 0; i < instance_count; i++) {
+        if (strcmp(instances[i].confdir, confdir) == 0)
+            return &instances[i];
+    }
+    return NULL;
+}
+
+static int add_confdir(const char *confdir){
+
+    InstanceInfo *inst = find_by_confdir(confdir);
+
+    if (inst != NULL)
+        return load_instance(inst);
+
+    if (instance_count == instance_cap) {
+        int cap = instance_cap ? instance_cap * 2 : 8;
+        InstanceInfo *n = realloc(instances, cap * sizeof(InstanceInfo));
+        if (n == NULL)
+            return 0;
+        instances = n;
+        instance_cap = cap;
+    }
+
+    inst = &instances[instance_count++];
+    memset(inst, 0, sizeof(InstanceInfo));
+    inst->pidfd = -1;
+    inst->wd = -1;
+    snprintf(inst->confdir, sizeof(inst->confdir), "%s", confdir);
+
+    return load_instance(inst);
+}
+
+static int remove_instance(InstanceInfo *inst){
+
+    int was_running = inst->running;
+
+    close_pidfd(inst);
+    if (inst->wd >= 0)
+        inotify_rm_watch(inotify_fd, inst->wd);
+
+    instance_count--;
+    memmove(inst, inst + 1, (char *) (instances + instance_count) - (char *) inst);
+    return was_running;
+}
+
+static int rescan(void){
+
+    glob_t g;
+    int changed = 0;
+
+    if (glob(CONFDIR_GLOB, GLOB_ONLYDIR, NULL, &g) != 0)
+        g.gl_pathc = 0;
+
+    for (int i = instance_count - 1; i >= 0; i--) {
+        int found = 0;
+        for (size_t j = 0; j < g.gl_pathc && !found; j++)
+            found = strcmp(instances[i].confdir, g.gl_pathv[j]) == 0;
+        if (!found)
+            changed |= remove_instance(&instances[i]);
+    }
+
+    for (size_t j = 0; j < g.gl_pathc; j++)
+        changed |= add_confdir(g.gl_pathv[j]);
+
+    if (g.gl_pathc > 0)
+        globfree(&g);
+    return changed;
+}
+
+/**
+ * Set up the watches and load the instances that are already running.
+ * Returns the fd to poll, or -1.
+ */
+int instance_watch_open(void){
+
+    struct epoll_event ev = {.events = EPOLLIN};
+
+    if (epoll_fd >= 0)
+        return epoll_fd;
+
+    if ((epoll_fd = epoll_create1(EPOLL_CLOEXEC)) < 0)
+        return -1;
+
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0 || (tmp_wd = inotify_add_watch(inotify_fd, TMP_DIR, TMP_EVENTS)) < 0) {
+        instance_watch_close();
+        return -1;
+    }
+
+    ev.data.fd = inotify_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, inotify_fd, &ev);
+
+    rescan();
+    return epoll_fd;
+}
+
+int instance_watch_fd(void){
+    return epoll_fd;
+}
+
+static int handle_inotify(void){
+
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    char path[PATH_MAX];
+    int changed = 0;
+    ssize_t n;
+
+    while ((n = read(inotify_fd, buf, sizeof(buf))) > 0) {
+        for (char *p = buf; p < buf + n; ) {
+            struct inotify_event *ev = (struct inotify_event *) p;
+            p += sizeof(struct inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW)
+                return rescan();
+
+            if (ev->wd == tmp_wd) {
+                InstanceInfo *inst;
+
+                if (ev->len == 0 || !is_confdir_name(ev->name))
+                    continue;
+
+                snprintf(path, sizeof(path), "%s/%s", TMP_DIR, ev->name);
+
+                if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    if ((inst = find_by_confdir(path)) != NULL)
+                        changed |= remove_instance(inst);
+                } else {
+                    // Also retried on IN_ATTRIB: the directory is 0700 until create_ap chmods it
+                    changed |= add_confdir(path);
+                }
+                continue;
+            }
+
+            for (int i = 0; i < instance_count; i++) {
+                if (instances[i].wd != ev->wd)
+                    continue;
+                if (ev->mask & IN_IGNORED)
+                    instances[i].wd = -1;
+                else
+                    changed |= load_instance(&instances[i]);
+                break;
+            }
+        }
+    }
+
+    return changed;
+}
+
+/**
+ * Handle pending events. Returns 1 if an instance started, stopped or
+ * exited.
+ */
+int instance_watch_dispatch(void){
+
+    struct epoll_event events[16];
+    int changed = 0;
+    int n;
+
+    if (epoll_fd < 0)
+        return 0;
+
+    while ((n = epoll_wait(epoll_fd, events, 16, 0)) > 0) {
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.fd == inotify_fd) {
+                changed |= handle_inotify();
+                continue;
+            }
+
+            // A readable pidfd means the process has exited
+            for (int j = 0; j < instance_count; j++) {
+                if (instances[j].pidfd == events[i].data.fd) {
+                    close_pidfd(&instances[j]);
+                    instances[j].running = 0;
+                    changed = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Without pidfd support exits are only noticed here
+    for (int i = 0; i < instance_count; i++) {
+        if (instances[i].running && instances[i].pidfd < 0 && !pid_alive(instances[i].pid)) {
+            instances[i].running = 0;
+            changed = 1;
+        }
+    }
+
+    return changed;
+}
+
+/**
+ * True if a running instance could not be given a pidfd (Linux < 5.3), in
+ * which case instance_watch_dispatch() has to be called periodically.
+ */
+int instance_watch_needs_poll(void){
+
+    for (int i = 0; i < instance_count; i++) {
+        if (instances[i].running && instances[i].pidfd < 0)
+            return 1;
+    }
+    return 0;
+}
+
+void instance_watch_close(void){
+
+    while (instance_count > 0)
+        remove_instance(&instances[instance_count - 1]);
+
+    if (inotify_fd >= 0)
+        close(inotify_fd);
+    if (epoll_fd >= 0)
+        close(epoll_fd);
+
+    inotify_fd = -1;
+    epoll_fd = -1;
+    tmp_wd = -1;
+}
+
+int instance_watch_count(void){
+    return instance_count;
+}
+
+const InstanceInfo *instance_watch_get(int i){
+
+    if (i < 0 || i >= instance_count)
+        return NULL;
+
+    return &instances[i];
+}
+
+/**
+ * The most recently seen running instance, as the last line of
+ * create_ap --list-running.
+ */
+const InstanceInfo *instance_watch_current(void){
+
+    for (int i = instance_count - 1; i >= 0; i--) {
+        if (instances[i].running)
+            return &instances[i];
+    }
+    return NULL;
+}
@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_INSTANCE_WATCH_H
+#define WIHOTSPOT_INSTANCE_WATCH_H
+
+#include <limits.h>
+#include <net/if.h>
+#include <sys/types.h>
+
+/*
+ * Running create_ap instances, followed without polling.
+ *
+ * Config directories /tmp/create_ap.<iface>.conf.* are tracked with
+ * inotify, and every instance pid is held as a pidfd which becomes readable
+ * when the process exits. All descriptors are collected in one epoll set,
+ * so a single fd has to be watched by the main loop.
+ */
+
+typedef struct {
+    pid_t pid;
+    int pidfd;              // -1 if pidfd_open() is not available
+    int wd;                 // inotify watch of confdir
+    char confdir[PATH_MAX];
+    char iface[IF_NAMESIZE];
+    int running;
+} InstanceInfo;
+
+int instance_watch_open(void);
+int instance_watch_fd(void);
+int instance_watch_dispatch(void);
+int instance_watch_needs_poll(void);
+void instance_watch_close(void);
+
+int instance_watch_count(void);
+const InstanceInfo *instance_watch_get(int i);
+const InstanceInfo *instance_watch_current(void);
+
+#endif //WIHOTSPOT_INSTANCE_WATCH_H
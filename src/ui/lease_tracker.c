@@ -0,0 +1,499 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/inotify.h>
+
+#include "lease_tracker.h"
+
+#define LEASE_FILE_NAME "dnsmasq.leases"
+#define MIN_SLOTS 64
+#define LINE_MAX_LEN 512
+
+typedef struct {
+    LeaseInfo info;
+    size_t offset;          // line in text, or in the new data once seen
+    size_t len;
+    uint32_t seen;          // generation of the last feed that had it
+} LeaseRecord;
+
+struct LeaseTracker {
+    char confdir[PATH_MAX];
+    char path[PATH_MAX];
+    int inotify_fd;
+
+    char *text;             // file contents as last parsed
+    size_t text_len;
+    size_t text_cap;
+
+    LeaseRecord *records;   // one per MAC
+    int count;
+    int cap;
+    uint32_t generation;
+
+    int32_t *slots;         // latest record by MAC, -1 if empty
+    uint32_t slot_mask;
+    int keys;
+};
+
+static uint32_t hash_mac(const unsigned char *mac){
+
+    uint32_t h = 2166136261u;
+
+    for (int i = 0; i < 6; i++) {
+        h ^= mac[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t find_slot(const LeaseTracker *t, const unsigned char *mac){
+
+    uint32_t s = hash_mac(mac) & t->slot_mask;
+
+    while (t->slots[s] >= 0 && memcmp(t->records[t->slots[s]].info.mac, mac, 6) != 0)
+        s = (s + 1) & t->slot_mask;
+
+    return s;
+}
+
+static void index_record(LeaseTracker *t, int i){
+
+    uint32_t s = find_slot(t, t->records[i].info.mac);
+
+    if (t->slots[s] < 0)
+        t->keys++;
+    t->slots[s] = i;
+}
+
+/**
+ * Rebuild the MAC index over the first n records. Only hashing, the
+ * records themselves are not parsed again.
+ */
+static int rebuild_index(LeaseTracker *t, int n){
+
+    uint32_t size = MIN_SLOTS;
+
+    while (size < (uint32_t) (n + 1) * 2)
+        size *= 2;
+
+    if (size != t->slot_mask + 1) {
+        int32_t *slots = malloc(size * sizeof(int32_t));
+        if (slots == NULL)
+            return -1;
+        free(t->slots);
+        t->slots = slots;
+        t->slot_mask = size - 1;
+    }
+
+    memset(t->slots, 0xff, size * sizeof(int32_t));
+    t->keys = 0;
+
+    for (int i = 0; i < n; i++)
+        index_record(t, i);
+
+    return 0;
+}
+
+static int hex_value(char c){
+
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * The MAC address of a lease line, found without parsing the rest of it.
+ * Fails for IPv6 and duid lines.
+ */
+static int line_mac(const char *data, size_t len, unsigned char *mac){
+
+    size_t i = 0;
+
+    while (i < len && data[i] != ' ' && data[i] != '\t')
+        i++;
+    while (i < len && (data[i] == ' ' || data[i] == '\t'))
+        i++;
+
+    if (len - i < 17 || (len - i > 17 && data[i + 17] != ' ' && data[i + 17] != '\t'))
+        return -1;
+
+    for (int b = 0; b < 6; b++, i += 3) {
+        int hi = hex_value(data[i]);
+        int lo = hex_value(data[i + 1]);
+
+        if (hi < 0 || lo < 0 || (b < 5 && data[i + 2] != ':'))
+            return -1;
+        mac[b] = (unsigned char) (hi << 4 | lo);
+    }
+    return 0;
+}
+
+static int parse_mac(const char *s, unsigned char *mac){
+
+    unsigned int b[6];
+    int n = 0;
+
+    if (sscanf(s, "%2x:%2x:%2x:%2x:%2x:%2x%n", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &n) != 6
+        || s[n] != '\0')
+        return -1;
+
+    for (int i = 0; i < 6; i++)
+        mac[i] = (unsigned char) b[i];
+    return 0;
+}
+
+/**
+ * Parse one "<expiry> <mac> <ip> <hostname> <client id>" line. IPv6 and
+ * duid lines do not have a MAC address and are skipped.
+ */
+static int parse_line(const char *data, size_t len, LeaseInfo *info){
+
+    char line[LINE_MAX_LEN];
+    char *save = NULL;
+    char *expiry, *mac, *ip, *hostname, *end;
+    struct in_addr addr;
+
+    if (len >= sizeof(line))
+        return -1;
+
+    memcpy(line, data, len);
+    line[len] = '\0';
+
+    if ((expiry = strtok_r(line, " \t\r", &save)) == NULL
+        || (mac = strtok_r(NULL, " \t\r", &save)) == NULL
+        || (ip = strtok_r(NULL, " \t\r", &save)) == NULL)
+        return -1;
+
+    hostname = strtok_r(NULL, " \t\r", &save);
+
+    info->expiry = strtoll(expiry, &end, 10);
+    if (*end != '\0' || parse_mac(mac, info->mac) < 0 || inet_pton(AF_INET, ip, &addr) != 1)
+        return -1;
+
+    info->ipv4 = addr.s_addr;
+    snprintf(info->hostname, sizeof(info->hostname), "%s", hostname != NULL ? hostname : "*");
+    return 0;
+}
+
+static LeaseRecord *add_record(LeaseTracker *t, const LeaseInfo *info){
+
+    if (t->count == t->cap) {
+        int cap = t->cap ? t->cap * 2 : 64;
+        LeaseRecord *n = realloc(t->records, cap * sizeof(LeaseRecord));
+        if (n == NULL)
+            return NULL;
+        t->records = n;
+        t->cap = cap;
+    }
+
+    if ((uint32_t) (t->count + 1) * 2 > t->slot_mask + 1 && rebuild_index(t, t->count) < 0)
+        return NULL;
+
+    t->records[t->count].info = *info;
+    index_record(t, t->count);
+    return &t->records[t->count++];
+}
+
+static int reserve_text(LeaseTracker *t, size_t len){
+
+    if (len > t->text_cap) {
+        size_t cap = t->text_cap ? t->text_cap : 4096;
+        char *n;
+
+        while (cap < len)
+            cap *= 2;
+        if ((n = realloc(t->text, cap)) == NULL)
+            return -1;
+        t->text = n;
+        t->text_cap = cap;
+    }
+    return 0;
+}
+
+/**
+ * Whether the line of record r is the same as line. Records already seen
+ * in this feed point into data, the others into the previous contents.
+ */
+static int same_line(const LeaseTracker *t, const LeaseRecord *r, const char *data, const char *line, size_t len){
+
+    const char *old = (r->seen == t->generation ? data : t->text) + r->offset;
+
+    return r->len == len && memcmp(old, line, len) == 0;
+}
+
+/**
+ * Apply new contents of the lease file. dnsmasq rewrites the whole file and
+ * puts new leases first, so every line is looked up by its MAC address and
+ * only parsed if it differs from the line the record was parsed from.
+ * Records whose MAC is no longer in the file are removed.
+ * Returns 1 if a lease changed, 0 if not, -1 on error.
+ */
+int lease_tracker_feed(LeaseTracker *t, const char *data, size_t len){
+
+    size_t start = 0;
+    int changed = 0;
+    int kept = 0;
+
+    if (len == t->text_len && (len == 0 || memcmp(t->text, data, len) == 0))
+        return 0;
+
+    if (reserve_text(t, len) < 0)
+        return -1;
+
+    t->generation++;
+
+    while (start < len) {
+        const char *nl = memchr(data + start, '\n', len - start);
+        const char *line = data + start;
+        size_t line_len = (nl != NULL ? (size_t) (nl - data) : len) - start;
+        unsigned char mac[6];
+        int32_t i;
+        LeaseRecord *r;
+        LeaseInfo info;
+
+        start += line_len + 1;
+
+        if (line_mac(line, line_len, mac) < 0)
+            continue;
+
+        i = t->slots[find_slot(t, mac)];
+        r = i >= 0 ? &t->records[i] : NULL;
+
+        if (r == NULL || !same_line(t, r, data, line, line_len)) {
+            if (parse_line(line, line_len, &info) < 0)
+                continue;
+            // A later lease for the same MAC wins, as in create_ap
+            if (r != NULL)
+                r->info = info;
+            else if ((r = add_record(t, &info)) == NULL)
+                return -1;
+            changed = 1;
+        }
+
+        r->offset = line - data;
+        r->len = line_len;
+        r->seen = t->generation;
+    }
+
+    for (int i = 0; i < t->count; i++) {
+        if (t->records[i].seen == t->generation)
+            t->records[kept++] = t->records[i];
+    }
+
+    if (kept != t->count) {
+        // Only hashing, the records themselves are not parsed again
+        t->count = kept;
+        if (rebuild_index(t, kept) < 0)
+            return -1;
+        changed = 1;
+    }
+
+    memcpy(t->text, data, len);
+    t->text_len = len;
+    return changed;
+}
+
+/**
+ * Read the lease file and apply it. A missing file means no leases.
+ */
+int lease_tracker_reload(LeaseTracker *t){
+
+    char *buf = NULL;
+    size_t len = 0, cap = 0;
+    int fd, r;
+
+    fd = open(t->path, O_RDONLY | O_CLOEXEC);
+
+    while (fd >= 0) {
+        ssize_t n;
+
+        if (len == cap) {
+            char *b;
+            cap = cap ? cap * 2 : (t->text_len + 4096);
+            if ((b = realloc(buf, cap)) == NULL)
+                break;
+            buf = b;
+        }
+
+        n = read(fd, buf + len, cap - len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        len += n;
+    }
+
+    if (fd >= 0)
+        close(fd);
+
+    r = lease_tracker_feed(t, buf != NULL ? buf : "", len);
+    free(buf);
+    return r;
+}
+
+#define LEASE_WATCH_MASK (IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO | IN_DELETE)
+
+/*
+ * The instances of a supervisor link their lease file to the one of the
+ * shared dnsmasq. Changes show up in the directory of the target only.
+ */
+static void watch_link_target(LeaseTracker *t){
+
+    char target[PATH_MAX];
+    ssize_t n = readlink(t->path, target, sizeof(target) - 1);
+    char *slash;
+
+    if (n <= 0 || target[0] != '/')
+        return;
+    target[n] = '\0';
+
+    slash = strrchr(target, '/');
+    if (slash == target)
+        slash[1] = '\0';
+    else
+        *slash = '\0';
+
+    inotify_add_watch(t->inotify_fd, target, LEASE_WATCH_MASK);
+}
+
+LeaseTracker *lease_tracker_new(const char *confdir){
+
+    LeaseTracker *t = calloc(1, sizeof(LeaseTracker));
+
+    if (t == NULL)
+        return NULL;
+
+    t->inotify_fd = -1;
+
+    if (rebuild_index(t, 0) < 0) {
+        free(t);
+        return NULL;
+    }
+
+    if (confdir == NULL)
+        return t;
+
+    snprintf(t->confdir, sizeof(t->confdir), "%s", confdir);
+    snprintf(t->path, sizeof(t->path), "%s/%s", confdir, LEASE_FILE_NAME);
+
+    // dnsmasq keeps the file open and rewrites it in place
+    t->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (t->inotify_fd >= 0
+        && inotify_add_watch(t->inotify_fd, confdir, LEASE_WATCH_MASK | IN_DELETE_SELF) < 0) {
+        close(t->inotify_fd);
+        t->inotify_fd = -1;
+    }
+    if (t->inotify_fd >= 0)
+        watch_link_target(t);
+
+    lease_tracker_reload(t);
+    return t;
+}
+
+void lease_tracker_free(LeaseTracker *t){
+
+    if (t == NULL)
+        return;
+
+    if (t->inotify_fd >= 0)
+        close(t->inotify_fd);
+    free(t->text);
+    free(t->records);
+    free(t->slots);
+    free(t);
+}
+
+/**
+ * inotify descriptor to poll, or -1 if the directory can not be watched.
+ */
+int lease_tracker_fd(const LeaseTracker *t){
+    return t->inotify_fd;
+}
+
+/**
+ * Consume pending inotify events and reload the leases if the lease file
+ * was touched. Without inotify the file is always read again.
+ * Returns 1 if the leases changed.
+ */
+int lease_tracker_dispatch(LeaseTracker *t){
+
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int touched = 0;
+    ssize_t n;
+
+    if (t->inotify_fd < 0)
+        return lease_tracker_reload(t) > 0;
+
+    while ((n = read(t->inotify_fd, buf, sizeof(buf))) > 0) {
+        for (char *p = buf; p < buf + n; ) {
+            struct inotify_event *ev = (struct inotify_event *) p;
+
+            if ((ev->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF))
+                || (ev->len > 0 && strcmp(ev->name, LEASE_FILE_NAME) == 0))
+                touched = 1;
+
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+
+    if (!touched)
+        return 0;
+
+    // the link may have been created after the tracker
+    watch_link_target(t);
+    return lease_tracker_reload(t) > 0;
+}
+
+/**
+ * Number of distinct MAC addresses with a lease.
+ */
+int lease_tracker_count(const LeaseTracker *t){
+    return t->keys;
+}
+
+const LeaseInfo *lease_tracker_lookup(const LeaseTracker *t, const unsigned char *mac){
+
+    int32_t i = t->slots[find_slot(t, mac)];
+
+    return i >= 0 ? &t->records[i].info : NULL;
+}
+
+const char *lease_tracker_confdir(const LeaseTracker *t){
+    return t->confdir;
+}
@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_LEASE_TRACKER_H
+#define WIHOTSPOT_LEASE_TRACKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Follows the dnsmasq lease file of a hotspot.
+ *
+ * The config directory is watched with inotify. dnsmasq rewrites the whole
+ * file on every change, so each line of the new contents is compared with
+ * the line its MAC address was last parsed from. Only new or changed lines
+ * are parsed again. The result is kept as a MAC -> lease map.
+ */
+
+typedef struct {
+    unsigned char mac[6];
+    uint32_t ipv4;          // network byte order
+    long long expiry;       // unix time, 0 for infinite leases
+    char hostname[64];      // "*" if unknown
+} LeaseInfo;
+
+typedef struct LeaseTracker LeaseTracker;
+
+LeaseTracker *lease_tracker_new(const char *confdir);
+void lease_tracker_free(LeaseTracker *t);
+
+int lease_tracker_fd(const LeaseTracker *t);
+int lease_tracker_dispatch(LeaseTracker *t);
+int lease_tracker_reload(LeaseTracker *t);
+int lease_tracker_feed(LeaseTracker *t, const char *data, size_t len);
+
+int lease_tracker_count(const LeaseTracker *t);
+const LeaseInfo *lease_tracker_lookup(const LeaseTracker *t, const unsigned char *mac);
+const char *lease_tracker_confdir(const LeaseTracker *t);
+
+#endif //WIHOTSPOT_LEASE_TRACKER_H
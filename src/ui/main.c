@@ -25,11 +25,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <string.h>
+
+#include "qr_batch.h"
 #include "ui.h"
 
 
 int main(int argc, char *argv[]) {
 
+    // prints guest cards without opening a window
+    if (argc > 1 && strcmp(argv[1], "--qr-batch") == 0)
+        return qr_batch_main(argc - 1, argv + 1);
+
     g_set_prgname("wihotspot");
     initUi(argc,argv);
 
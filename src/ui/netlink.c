@@ -0,0 +1,304 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/genetlink.h>
+
+#include "netlink.h"
+
+static uint32_t netlink_seq;
+
+int netlink_open(int protocol){
+
+    struct sockaddr_nl sa;
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, protocol);
+
+    if (fd < 0)
+        return -1;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.nl_family = AF_NETLINK;
+
+    if (bind(fd, (struct sockaddr *) &sa, sizeof(sa)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int netlink_add_membership(int fd, unsigned int group){
+    return setsockopt(fd, SOL_NETLINK, NETLINK_ADD_MEMBERSHIP, &group, sizeof(group));
+}
+
+void netlink_msg_init(struct nlmsghdr *nlh, uint16_t type, uint16_t flags){
+    memset(nlh, 0, NLMSG_HDRLEN);
+    nlh->nlmsg_len = NLMSG_HDRLEN;
+    nlh->nlmsg_type = type;
+    nlh->nlmsg_flags = NLM_F_REQUEST | flags;
+}
+
+void *netlink_msg_put(struct nlmsghdr *nlh, size_t cap, const void *data, size_t len){
+
+    void *dst = (char *) nlh + NLMSG_ALIGN(nlh->nlmsg_len);
+
+    if (NLMSG_ALIGN(nlh->nlmsg_len) + NLMSG_ALIGN(len) > cap)
+        return NULL;
+
+    if (data != NULL)
+        memcpy(dst, data, len);
+    else
+        memset(dst, 0, len);
+
+    nlh->nlmsg_len = NLMSG_ALIGN(nlh->nlmsg_len) + NLMSG_ALIGN(len);
+    return dst;
+}
+
+int netlink_put_attr(struct nlmsghdr *nlh, size_t cap, uint16_t type, const void *data, size_t len){
+
+    struct nlattr *attr = (struct nlattr *) ((char *) nlh + NLMSG_ALIGN(nlh->nlmsg_len));
+
+    if (NLMSG_ALIGN(nlh->nlmsg_len) + NLA_HDRLEN + NLA_ALIGN(len) > cap)
+        return -1;
+
+    attr->nla_type = type;
+    attr->nla_len = NLA_HDRLEN + len;
+    memcpy((char *) attr + NLA_HDRLEN, data, len);
+
+    nlh->nlmsg_len = NLMSG_ALIGN(nlh->nlmsg_len) + NLA_HDRLEN + NLA_ALIGN(len);
+    return 0;
+}
+
+/**
+ * Read one batch of datagrams from fd and hand every message to cb.
+ * Returns 1 once NLMSG_DONE or an ack/error for seq has been seen, 0 if more
+ * messages are expected and -1 on socket errors. *error receives the kernel
+ * error code, if any.
+ */
+static int netlink_recv(int fd, uint32_t seq, netlink_msg_cb cb, void *arg, int *error){
+
+    static char buf[NETLINK_BUFSIZE];
+    struct nlmsghdr *nlh;
+    ssize_t len;
+
+    do {
+        len = recv(fd, buf, sizeof(buf), 0);
+    } while (len < 0 && errno == EINTR);
+
+    if (len < 0)
+        return -1;
+
+    for (nlh = (struct nlmsghdr *) buf; NLMSG_OK(nlh, (size_t) len); nlh = NLMSG_NEXT(nlh, len)) {
+
+        if (seq != 0 && nlh->nlmsg_seq != seq)
+            continue;
+
+        if (nlh->nlmsg_type == NLMSG_DONE)
+            return 1;
+
+        if (nlh->nlmsg_type == NLMSG_ERROR) {
+            struct nlmsgerr *err = (struct nlmsgerr *) NLMSG_DATA(nlh);
+            if (err->error != 0)
+                *error = err->error;
+            return 1;
+        }
+
+        if (cb != NULL && cb(nlh, arg) < 0 && *error == 0)
+            *error = -ECANCELED;
+    }
+
+    return 0;
+}
+
+/**
+ * Send a request and wait for the whole reply. Dump requests end with
+ * NLMSG_DONE, everything else is sent with NLM_F_ACK and ends with the ack.
+ * Returns 0 on success or a negative errno value.
+ */
+int netlink_request(int fd, struct nlmsghdr *req, netlink_msg_cb cb, void *arg){
+
+    struct sockaddr_nl sa;
+    int error = 0;
+    int r;
+
+    if (!(req->nlmsg_flags & NLM_F_DUMP))
+        req->nlmsg_flags |= NLM_F_ACK;
+
+    req->nlmsg_seq = ++netlink_seq;
+    req->nlmsg_pid = 0;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.nl_family = AF_NETLINK;
+
+    if (sendto(fd, req, req->nlmsg_len, 0, (struct sockaddr *) &sa, sizeof(sa)) < 0)
+        return -errno;
+
+    while ((r = netlink_recv(fd, req->nlmsg_seq, cb, arg, &error)) == 0);
+
+    if (r < 0)
+        return -errno;
+
+    return error;
+}
+
+/**
+ * Drain multicast notifications that are already queued on a non blocking
+ * socket. Returns the number of messages handed to cb, or -1 if the socket
+ * overran and events were lost (the caller should do a full resync).
+ */
+int netlink_dispatch(int fd, netlink_msg_cb cb, void *arg){
+
+    static char buf[NETLINK_BUFSIZE];
+    struct nlmsghdr *nlh;
+    ssize_t len;
+    int count = 0;
+
+    for (;;) {
+        len = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == ENOBUFS)
+                return -1;
+            break;
+        }
+
+        for (nlh = (struct nlmsghdr *) buf; NLMSG_OK(nlh, (size_t) len); nlh = NLMSG_NEXT(nlh, len)) {
+            if (nlh->nlmsg_type == NLMSG_DONE || nlh->nlmsg_type == NLMSG_ERROR)
+                continue;
+            cb(nlh, arg);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void netlink_parse_attrs(struct nlattr **tb, int max, const void *data, int len){
+
+    const struct nlattr *attr = (const struct nlattr *) data;
+
+    memset(tb, 0, sizeof(struct nlattr *) * (max + 1));
+
+    while (len >= (int) NLA_HDRLEN && attr->nla_len >= NLA_HDRLEN && attr->nla_len <= len) {
+        int type = attr->nla_type & NLA_TYPE_MASK;
+
+        if (type <= max)
+            tb[type] = (struct nlattr *) attr;
+
+        len -= NLA_ALIGN(attr->nla_len);
+        attr = (const struct nlattr *) ((const char *) attr + NLA_ALIGN(attr->nla_len));
+    }
+}
+
+void netlink_parse_nested(struct nlattr **tb, int max, const struct nlattr *nested){
+    netlink_parse_attrs(tb, max, netlink_attr_data(nested), netlink_attr_len(nested));
+}
+
+void *netlink_attr_data(const struct nlattr *attr){
+    return (char *) attr + NLA_HDRLEN;
+}
+
+int netlink_attr_len(const struct nlattr *attr){
+    return attr->nla_len - NLA_HDRLEN;
+}
+
+uint8_t netlink_attr_u8(const struct nlattr *attr){
+    return *(uint8_t *) netlink_attr_data(attr);
+}
+
+uint16_t netlink_attr_u16(const struct nlattr *attr){
+    uint16_t v;
+    memcpy(&v, netlink_attr_data(attr), sizeof(v));
+    return v;
+}
+
+uint32_t netlink_attr_u32(const struct nlattr *attr){
+    uint32_t v;
+    memcpy(&v, netlink_attr_data(attr), sizeof(v));
+    return v;
+}
+
+uint64_t netlink_attr_u64(const struct nlattr *attr){
+    uint64_t v;
+    memcpy(&v, netlink_attr_data(attr), sizeof(v));
+    return v;
+}
+
+static int genl_family_cb(struct nlmsghdr *nlh, void *arg){
+
+    struct nlattr *tb[CTRL_ATTR_MAX + 1];
+    int len;
+    void *attrs = genl_msg_attrs(nlh, &len);
+
+    netlink_parse_attrs(tb, CTRL_ATTR_MAX, attrs, len);
+
+    if (tb[CTRL_ATTR_FAMILY_ID])
+        *(int *) arg = netlink_attr_u16(tb[CTRL_ATTR_FAMILY_ID]);
+
+    return 0;
+}
+
+/**
+ * Resolve a generic netlink family (ex: "nl80211") to its id.
+ * Returns -1 if the family is not registered.
+ */
+int genl_family_id(int fd, const char *name){
+
+    char buf[256];
+    struct nlmsghdr *nlh = (struct nlmsghdr *) buf;
+    int id = -1;
+
+    genl_msg_init(nlh, GENL_ID_CTRL, CTRL_CMD_GETFAMILY, 0);
+    netlink_put_attr(nlh, sizeof(buf), CTRL_ATTR_FAMILY_NAME, name, strlen(name) + 1);
+
+    if (netlink_request(fd, nlh, genl_family_cb, &id) < 0)
+        return -1;
+
+    return id;
+}
+
+void genl_msg_init(struct nlmsghdr *nlh, uint16_t family, uint8_t cmd, uint16_t flags){
+
+    struct genlmsghdr *genl;
+
+    netlink_msg_init(nlh, family, flags);
+    genl = (struct genlmsghdr *) ((char *) nlh + NLMSG_HDRLEN);
+    memset(genl, 0, GENL_HDRLEN);
+    genl->cmd = cmd;
+    genl->version = 1;
+    nlh->nlmsg_len += GENL_HDRLEN;
+}
+
+void *genl_msg_attrs(struct nlmsghdr *nlh, int *len){
+    *len = nlh->nlmsg_len - NLMSG_HDRLEN - GENL_HDRLEN;
+    return (char *) NLMSG_DATA(nlh) + GENL_HDRLEN;
+}
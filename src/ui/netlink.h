@@ -0,0 +1,68 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_NETLINK_H
+#define WIHOTSPOT_NETLINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <linux/netlink.h>
+
+#define NETLINK_BUFSIZE 32768
+
+/*
+ * Small helpers around raw AF_NETLINK sockets. They are used to talk to
+ * rtnetlink and nl80211 (through generic netlink) without forking iw/ip.
+ */
+
+typedef int (*netlink_msg_cb)(struct nlmsghdr *nlh, void *arg);
+
+int netlink_open(int protocol);
+int netlink_add_membership(int fd, unsigned int group);
+
+void netlink_msg_init(struct nlmsghdr *nlh, uint16_t type, uint16_t flags);
+void *netlink_msg_put(struct nlmsghdr *nlh, size_t cap, const void *data, size_t len);
+int netlink_put_attr(struct nlmsghdr *nlh, size_t cap, uint16_t type, const void *data, size_t len);
+
+int netlink_request(int fd, struct nlmsghdr *req, netlink_msg_cb cb, void *arg);
+int netlink_dispatch(int fd, netlink_msg_cb cb, void *arg);
+
+void netlink_parse_attrs(struct nlattr **tb, int max, const void *data, int len);
+void netlink_parse_nested(struct nlattr **tb, int max, const struct nlattr *nested);
+
+void *netlink_attr_data(const struct nlattr *attr);
+int netlink_attr_len(const struct nlattr *attr);
+uint8_t netlink_attr_u8(const struct nlattr *attr);
+uint16_t netlink_attr_u16(const struct nlattr *attr);
+uint32_t netlink_attr_u32(const struct nlattr *attr);
+uint64_t netlink_attr_u64(const struct nlattr *attr);
+
+int genl_family_id(int fd, const char *name);
+void genl_msg_init(struct nlmsghdr *nlh, uint16_t family, uint8_t cmd, uint16_t flags);
+void *genl_msg_attrs(struct nlmsghdr *nlh, int *len);
+
+#endif //WIHOTSPOT_NETLINK_H
@@ -0,0 +1,372 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include "qr_batch.h"
+#include "qrgen.h"
+#include "util.h"
+
+#define SLOTS_PER_JOB 4
+#define MAX_JOBS 64
+#define SSID_MAX 32
+#define PAYLOAD_SIZE 512
+#define CAPTION_SIZE 160
+
+typedef enum {
+    SLOT_QUEUED,
+    SLOT_DONE,
+    SLOT_FAILED
+} SlotState;
+
+typedef struct {
+    unsigned long line;
+    char *ssid;
+    char *password;
+    QrPdfPage page;
+    SlotState state;
+} Slot;
+
+/*
+ * Records are numbered in input order and record n goes in slot
+ * n % n_slots. Workers take records in order, the main thread reads,
+ * queues and writes out pages, so a slot is only reused once its page
+ * has been written.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t queued;
+    pthread_cond_t done;
+    Slot *slots;
+    long n_slots;
+    long n_queued;
+    long next_job;
+    int quit;
+    const QrRasterOptions *opts;
+} Batch;
+
+static int render_card(Slot *slot, const QrRasterOptions *opts){
+
+    char payload[PAYLOAD_SIZE], ssid_line[CAPTION_SIZE], password_line[CAPTION_SIZE];
+    const char *caption[2] = {ssid_line, password_line};
+    QRcode *qrcode;
+    int ret;
+
+    if (wifi_qr_string(payload, sizeof(payload), slot->ssid, "WPA", slot->password) < 0)
+        return -1;
+    qrcode = qr_encode(payload);
+    if (qrcode == NULL)
+        return -1;
+
+    snprintf(ssid_line, sizeof(ssid_line), "Wi-Fi: %s", slot->ssid);
+    if (*slot->password == '\0')
+        snprintf(password_line, sizeof(password_line), "Open network");
+    else
+        snprintf(password_line, sizeof(password_line), "Password: %s", slot->password);
+
+    ret = qr_pdf_page_render(&slot->page, qrcode->data, qrcode->width, opts, caption, 2);
+    QRcode_free(qrcode);
+    return ret;
+}
+
+static void *worker(void *data){
+
+    Batch *batch = data;
+    Slot *slot;
+    int ret;
+
+    pthread_mutex_lock(&batch->lock);
+    for (;;) {
+        while (!batch->quit && batch->next_job == batch->n_queued)
+            pthread_cond_wait(&batch->queued, &batch->lock);
+        if (batch->next_job == batch->n_queued)
+            break;
+
+        slot = &batch->slots[batch->next_job++ % batch->n_slots];
+        pthread_mutex_unlock(&batch->lock);
+
+        ret = render_card(slot, batch->opts);
+
+        pthread_mutex_lock(&batch->lock);
+        slot->state = ret == 0 ? SLOT_DONE : SLOT_FAILED;
+        pthread_cond_broadcast(&batch->done);
+    }
+    pthread_mutex_unlock(&batch->lock);
+
+    return NULL;
+}
+
+/**
+ * Wait for record n and write its page, or only free it if write is 0.
+ * Returns 0, or -1 after printing an error.
+ */
+static int write_card(Batch *batch, QrPdf *pdf, long n, int write){
+
+    Slot *slot = &batch->slots[n % batch->n_slots];
+    int ret = 0;
+
+    pthread_mutex_lock(&batch->lock);
+    while (slot->state == SLOT_QUEUED)
+        pthread_cond_wait(&batch->done, &batch->lock);
+    pthread_mutex_unlock(&batch->lock);
+
+    if (write && slot->state == SLOT_FAILED) {
+        fprintf(stderr, "line %lu: could not encode the QR code\n", slot->line);
+        ret = -1;
+    } else if (write && qr_pdf_add_page(pdf, &slot->page) < 0) {
+        perror("Could not write the PDF");
+        ret = -1;
+    }
+
+    qr_pdf_page_clear(&slot->page);
+    free(slot->ssid);
+    free(slot->password);
+    slot->ssid = slot->password = NULL;
+
+    return ret;
+}
+
+static int valid_password(const char *password){
+
+    size_t len = strlen(password);
+
+    if (len == 64) {
+        for (size_t i = 0; i < len; i++) {
+            if (!isxdigit((unsigned char) password[i]))
+                return 0;
+        }
+        return 1;
+    }
+    return len == 0 || (len >= 8 && len <= 63);
+}
+
+/**
+ * Read the next record into ssid and password. Returns 1, 0 at the end of
+ * input, or -1 after printing an error.
+ */
+static int read_record(FILE *input, char **line, size_t *size, unsigned long *line_no,
+                       char **ssid, char **password){
+
+    char *fields[2];
+    int n;
+
+    for (;;) {
+        if (getline(line, size, input) < 0) {
+            if (!ferror(input))
+                return 0;
+            perror("Could not read the CSV file");
+            return -1;
+        }
+        (*line_no)++;
+
+        n = csv_split(*line, fields, 2);
+        if (n == 1 && *fields[0] == '\0')
+            continue;
+        if (n < 0) {
+            fprintf(stderr, "line %lu: expected ssid,password\n", *line_no);
+            return -1;
+        }
+        if (*line_no == 1 && strcasecmp(fields[0], "ssid") == 0)
+            continue;
+
+        if (*fields[0] == '\0' || strlen(fields[0]) > SSID_MAX) {
+            fprintf(stderr, "line %lu: the SSID must be 1 to %d bytes\n", *line_no, SSID_MAX);
+            return -1;
+        }
+        if (n == 2 && !valid_password(fields[1])) {
+            fprintf(stderr, "line %lu: the password must be 8 to 63 characters or 64 hex digits\n", *line_no);
+            return -1;
+        }
+
+        *ssid = strdup(fields[0]);
+        *password = strdup(n == 2 ? fields[1] : "");
+        if (*ssid == NULL || *password == NULL) {
+            free(*ssid);
+            free(*password);
+            perror(NULL);
+            return -1;
+        }
+        return 1;
+    }
+}
+
+long qr_batch(FILE *input, FILE *output, const QrRasterOptions *opts, int jobs){
+
+    Batch batch;
+    pthread_t threads[MAX_JOBS];
+    QrPdf *pdf;
+    char *line = NULL;
+    size_t line_size = 0;
+    unsigned long line_no = 0;
+    long n = 0;
+    int started = 0, ret = 0;
+
+    if (jobs <= 0)
+        jobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (jobs <= 0)
+        jobs = 1;
+    if (jobs > MAX_JOBS)
+        jobs = MAX_JOBS;
+
+    memset(&batch, 0, sizeof(batch));
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.queued, NULL);
+    pthread_cond_init(&batch.done, NULL);
+    batch.opts = opts;
+    batch.n_slots = (long) jobs * SLOTS_PER_JOB;
+    batch.slots = calloc(batch.n_slots, sizeof(*batch.slots));
+    pdf = qr_pdf_new(output);
+    if (batch.slots == NULL || pdf == NULL) {
+        perror(NULL);
+        ret = -1;
+    }
+
+    for (; ret == 0 && started < jobs; started++) {
+        errno = pthread_create(&threads[started], NULL, worker, &batch);
+        if (errno != 0) {
+            perror("Could not start the QR threads");
+            ret = -1;
+            break;
+        }
+    }
+
+    while (ret == 0) {
+        Slot *slot = &batch.slots[n % batch.n_slots];
+        char *ssid, *password;
+        int r;
+
+        // the slot still holds the page of record n - n_slots
+        if (n >= batch.n_slots && write_card(&batch, pdf, n - batch.n_slots, 1) < 0) {
+            ret = -1;
+            break;
+        }
+
+        r = read_record(input, &line, &line_size, &line_no, &ssid, &password);
+        if (r <= 0) {
+            ret = r;
+            break;
+        }
+
+        slot->line = line_no;
+        slot->ssid = ssid;
+        slot->password = password;
+        slot->state = SLOT_QUEUED;
+
+        pthread_mutex_lock(&batch.lock);
+        batch.n_queued = ++n;
+        pthread_cond_signal(&batch.queued);
+        pthread_mutex_unlock(&batch.lock);
+    }
+
+    // write what is still queued in order, or only wait for it after an error
+    for (long i = n > batch.n_slots ? n - batch.n_slots : 0; i < n; i++) {
+        if (batch.slots[i % batch.n_slots].ssid != NULL && write_card(&batch, pdf, i, ret == 0) < 0)
+            ret = -1;
+    }
+
+    pthread_mutex_lock(&batch.lock);
+    batch.quit = 1;
+    pthread_cond_broadcast(&batch.queued);
+    pthread_mutex_unlock(&batch.lock);
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    if (pdf != NULL && qr_pdf_finish(pdf) < 0 && ret == 0) {
+        perror("Could not write the PDF");
+        ret = -1;
+    }
+
+    free(line);
+    free(batch.slots);
+    pthread_cond_destroy(&batch.done);
+    pthread_cond_destroy(&batch.queued);
+    pthread_mutex_destroy(&batch.lock);
+
+    return ret < 0 ? -1 : n;
+}
+
+static void usage(void){
+    fprintf(stderr, "Usage: wihotspot-gui --qr-batch [-j jobs] <file.csv> <file.pdf>\n\n"
+                    "Print a card with the QR code, SSID and password of each\n"
+                    "ssid,password record of file.csv, one per page of file.pdf.\n"
+                    "Use - for standard input or output.\n");
+}
+
+int qr_batch_main(int argc, char *argv[]){
+
+    FILE *input, *output;
+    const char *in_path, *out_path;
+    int jobs = 0, i = 1;
+    long pages;
+
+    if (i + 1 < argc && strcmp(argv[i], "-j") == 0) {
+        jobs = atoi(argv[i + 1]);
+        i += 2;
+    }
+    if (argc - i != 2 || jobs < 0) {
+        usage();
+        return 2;
+    }
+    in_path = argv[i];
+    out_path = argv[i + 1];
+
+    input = strcmp(in_path, "-") == 0 ? stdin : fopen(in_path, "r");
+    if (input == NULL) {
+        perror(in_path);
+        return 1;
+    }
+    output = strcmp(out_path, "-") == 0 ? stdout : fopen(out_path, "wb");
+    if (output == NULL) {
+        perror(out_path);
+        return 1;
+    }
+
+    pages = qr_batch(input, output, &qr_print_options, jobs);
+
+    if (output != stdout && fclose(output) != 0 && pages >= 0) {
+        perror(out_path);
+        pages = -1;
+    }
+    if (input != stdin)
+        fclose(input);
+
+    if (pages < 0) {
+        // do not leave a partial PDF behind
+        if (output != stdout)
+            unlink(out_path);
+        return 1;
+    }
+
+    fprintf(stderr, "%ld cards written to %s\n", pages, out_path);
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_QR_BATCH_H
+#define WIHOTSPOT_QR_BATCH_H
+
+#include <stdio.h>
+
+#include "qr_raster.h"
+
+/*
+ * Guest card printing: one PDF page per network of a CSV file, with the
+ * QR code and the SSID and passphrase written below it.
+ *
+ * Each CSV record is ssid,password. An empty password is an open network
+ * and a first record of ssid,... is taken as a header.
+ *
+ * Pages are encoded and rendered by a pool of threads and written in
+ * order as they complete. At most a few pages per thread are held in
+ * memory, whatever the length of the input.
+ */
+
+/**
+ * Write one page per record of input to output.
+ * jobs is the number of threads, 0 for one per CPU.
+ * Returns the number of pages, or -1 after printing an error to stderr.
+ */
+long qr_batch(FILE *input, FILE *output, const QrRasterOptions *opts, int jobs);
+
+/**
+ * Entry point of wihotspot-gui --qr-batch [-j jobs] <file.csv> <file.pdf>.
+ * argv[0] is "--qr-batch". Returns the exit status.
+ */
+int qr_batch_main(int argc, char *argv[]);
+
+#endif //WIHOTSPOT_QR_BATCH_H
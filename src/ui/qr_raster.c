@@ -0,0 +1,405 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "qr_raster.h"
+
+// bits from position i to the end of a byte, most significant bit first
+static const unsigned char TAIL_BITS[8] = {0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x01};
+
+int qr_raster_side(int width, const QrRasterOptions *opts){
+    return (width + opts->margin * 2) * opts->scale;
+}
+
+size_t qr_raster_stride(int width, const QrRasterOptions *opts){
+    return ((size_t) qr_raster_side(width, opts) + 7) / 8;
+}
+
+/**
+ * Find the next run of dark modules at or after *x. Returns its length and
+ * leaves *x at its start, or 0 at the end of the row.
+ */
+static int next_dark_run(const unsigned char *modules, int width, int *x){
+
+    int start, len;
+
+    while (*x < width && !(modules[*x] & 1))
+        (*x)++;
+    start = *x;
+    while (*x < width && (modules[*x] & 1))
+        (*x)++;
+
+    len = *x - start;
+    *x = start;
+    return len;
+}
+
+// Clear the pixels [from, to) of a scanline, a byte at a time
+static void clear_span(unsigned char *row, size_t from, size_t to){
+
+    size_t first = from / 8, last = to / 8;
+
+    if (first == last) {
+        row[first] &= ~(TAIL_BITS[from % 8] & ~TAIL_BITS[to % 8]);
+        return;
+    }
+
+    row[first] &= ~TAIL_BITS[from % 8];
+    memset(row + first + 1, 0, last - first - 1);
+    if (to % 8)
+        row[last] &= TAIL_BITS[to % 8];
+}
+
+void qr_raster_row(const unsigned char *modules, int width, const QrRasterOptions *opts,
+                   unsigned char *row){
+
+    size_t offset = (size_t) opts->margin * opts->scale;
+    int x = 0, len;
+
+    memset(row, 0xff, qr_raster_stride(width, opts));
+    if (modules == NULL)
+        return;
+
+    while ((len = next_dark_run(modules, width, &x)) > 0) {
+        clear_span(row, offset + (size_t) x * opts->scale, offset + (size_t) (x + len) * opts->scale);
+        x += len;
+    }
+}
+
+QrFormat qr_format_from_path(const char *path){
+
+    const char *ext = strrchr(path, '.');
+
+    if (ext != NULL && strcasecmp(ext, ".svg") == 0)
+        return QR_FORMAT_SVG;
+    if (ext != NULL && strcasecmp(ext, ".pdf") == 0)
+        return QR_FORMAT_PDF;
+    return QR_FORMAT_PNG;
+}
+
+typedef struct {
+    FILE *fp;
+    long offset;
+    int error;
+} Writer;
+
+static void out(Writer *w, const char *fmt, ...){
+
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vfprintf(w->fp, fmt, ap);
+    va_end(ap);
+
+    if (n < 0)
+        w->error = 1;
+    else
+        w->offset += n;
+}
+
+/**
+ * Format value / 10000 with four decimals. printf's %f would follow the
+ * locale set by gtk_init() and could write a decimal comma.
+ */
+static const char *fixed4(char buf[32], long long value){
+    snprintf(buf, 32, "%lld.%04lld", value / 10000, value % 10000);
+    return buf;
+}
+
+static int finish(Writer *w){
+    if (fflush(w->fp) != 0 || ferror(w->fp))
+        w->error = 1;
+    return w->error ? -1 : 0;
+}
+
+int qr_write_svg(FILE *fp, const unsigned char *data, int width, const QrRasterOptions *opts){
+
+    Writer w = {fp, 0, 0};
+    int side = width + opts->margin * 2;
+    // printed size in 1/10000 mm
+    long long size = (long long) qr_raster_side(width, opts) * 254000 / opts->dpi;
+    char buf[32];
+
+    out(&w, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    out(&w, "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"%smm\" ", fixed4(buf, size));
+    out(&w, "height=\"%smm\" viewBox=\"0 0 %d %d\" shape-rendering=\"crispEdges\">\n", buf, side, side);
+    out(&w, "<rect width=\"%d\" height=\"%d\" fill=\"#ffffff\"/>\n", side, side);
+    out(&w, "<path fill=\"#000000\" d=\"");
+
+    for (int y = 0; y < width; y++) {
+        const unsigned char *modules = data + (size_t) y * width;
+        int x = 0, len;
+
+        while ((len = next_dark_run(modules, width, &x)) > 0) {
+            out(&w, "M%d %dh%dv1h-%dz", opts->margin + x, opts->margin + y, len, len);
+            x += len;
+        }
+        out(&w, "\n");
+    }
+
+    out(&w, "\"/>\n</svg>\n");
+    return finish(&w);
+}
+
+/**
+ * Write a PDF string literal. The text is UTF-8 and the font uses
+ * WinAnsiEncoding, which matches Latin-1 from U+00A0 up.
+ */
+static void out_pdf_string(Writer *w, const char *text){
+
+    const unsigned char *p = (const unsigned char *) text;
+    unsigned int c;
+
+    out(w, "(");
+    while (*p) {
+        if (*p < 0x80) {
+            c = *p++;
+        } else if ((*p & 0xe0) == 0xc0 && (p[1] & 0xc0) == 0x80) {
+            c = (*p & 0x1f) << 6 | (p[1] & 0x3f);
+            p += 2;
+        } else {
+            // skip the rest of a longer sequence
+            for (p++; (*p & 0xc0) == 0x80; p++);
+            c = '?';
+        }
+
+        if (c == '(' || c == ')' || c == '\\')
+            out(w, "\\%c", c);
+        else if (c >= 0x20 && c < 0x7f)
+            out(w, "%c", c);
+        else if (c >= 0xa0 && c <= 0xff)
+            out(w, "\\%03o", c);
+        else
+            out(w, "?");
+    }
+    out(w, ")");
+}
+
+int qr_pdf_page_render(QrPdfPage *page, const unsigned char *data, int width, const QrRasterOptions *opts,
+                       const char *const *caption, int n_caption){
+
+    Writer w = {NULL, 0, 0};
+    int side = width + opts->margin * 2;
+    size_t longest = 1;
+    // sizes in 1/10000 pt
+    long long module = (long long) opts->scale * 720000 / opts->dpi;
+    long long code = module * side;
+    long long font, fit, line;
+    char buf[32], buf2[32];
+
+    memset(page, 0, sizeof(*page));
+    w.fp = open_memstream(&page->content, &page->length);
+    if (w.fp == NULL)
+        return -1;
+
+    for (int i = 0; i < n_caption; i++) {
+        if (strlen(caption[i]) > longest)
+            longest = strlen(caption[i]);
+    }
+    // Helvetica averages about 0.6 em per character, fit the longest line
+    // within the width of the symbol
+    font = code / 18;
+    fit = (code - 2 * opts->margin * module) * 10 / 6 / (long long) longest;
+    if (font > fit)
+        font = fit;
+    if (font < 40000)
+        font = 40000;
+    line = font * 14 / 10;
+
+    page->width = code;
+    page->height = code + n_caption * line;
+
+    out(&w, "1 g 0 0 %s ", fixed4(buf, page->width));
+    out(&w, "%s re f\n0 g\n", fixed4(buf, page->height));
+
+    for (int i = 0; i < n_caption; i++) {
+        out(&w, "BT /F1 %s Tf ", fixed4(buf, font));
+        out(&w, "%s ", fixed4(buf, opts->margin * module));
+        out(&w, "%s Td ", fixed4(buf2, (n_caption - 1 - i) * line + line * 3 / 10));
+        out_pdf_string(&w, caption[i]);
+        out(&w, " Tj ET\n");
+    }
+
+    // one unit per module, y pointing down from the top left corner
+    out(&w, "q %s 0 0 -%s 0 ", fixed4(buf, module), buf);
+    out(&w, "%s cm\n", fixed4(buf, page->height));
+    for (int y = 0; y < width; y++) {
+        const unsigned char *modules = data + (size_t) y * width;
+        int x = 0, len;
+
+        while ((len = next_dark_run(modules, width, &x)) > 0) {
+            out(&w, "%d %d %d 1 re\n", opts->margin + x, opts->margin + y, len);
+            x += len;
+        }
+    }
+    out(&w, "f Q\n");
+
+    if (fclose(w.fp) != 0 || w.error) {
+        qr_pdf_page_clear(page);
+        return -1;
+    }
+    return 0;
+}
+
+void qr_pdf_page_clear(QrPdfPage *page){
+    free(page->content);
+    page->content = NULL;
+    page->length = 0;
+}
+
+// Objects 1 to 3 are fixed, then each page is a page object and its content
+#define PDF_CATALOG 1
+#define PDF_PAGES 2
+#define PDF_FONT 3
+
+struct QrPdf {
+    Writer w;
+    long *xref;         // offset of each object, xref[0] is unused
+    int n_objects;
+    int n_pages;
+    int size;
+};
+
+static int pdf_begin_object(QrPdf *pdf, int object){
+
+    if (object >= pdf->size) {
+        int size = pdf->size * 2;
+        long *xref = realloc(pdf->xref, size * sizeof(*xref));
+
+        if (xref == NULL) {
+            pdf->w.error = 1;
+            return -1;
+        }
+        pdf->xref = xref;
+        pdf->size = size;
+    }
+    if (object > pdf->n_objects)
+        pdf->n_objects = object;
+
+    pdf->xref[object] = pdf->w.offset;
+    out(&pdf->w, "%d 0 obj\n", object);
+    return 0;
+}
+
+QrPdf *qr_pdf_new(FILE *fp){
+
+    QrPdf *pdf = calloc(1, sizeof(*pdf));
+
+    if (pdf == NULL)
+        return NULL;
+
+    pdf->w.fp = fp;
+    pdf->size = 64;
+    pdf->xref = calloc(pdf->size, sizeof(*pdf->xref));
+    if (pdf->xref == NULL) {
+        free(pdf);
+        return NULL;
+    }
+    // the page tree is written last, when all the pages are known
+    pdf->n_objects = PDF_PAGES;
+
+    out(&pdf->w, "%%PDF-1.4\n%%\xe2\xe3\xcf\xd3\n");
+    pdf_begin_object(pdf, PDF_CATALOG);
+    out(&pdf->w, "<< /Type /Catalog /Pages %d 0 R >>\nendobj\n", PDF_PAGES);
+    pdf_begin_object(pdf, PDF_FONT);
+    out(&pdf->w, "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica /Encoding /WinAnsiEncoding >>\nendobj\n");
+
+    return pdf;
+}
+
+int qr_pdf_add_page(QrPdf *pdf, const QrPdfPage *page){
+
+    int object = pdf->n_objects + 1;
+    char buf[32], buf2[32];
+
+    if (pdf_begin_object(pdf, object) < 0)
+        return -1;
+    out(&pdf->w, "<< /Type /Page /Parent %d 0 R /MediaBox [0 0 %s %s] /Contents %d 0 R "
+                 "/Resources << /Font << /F1 %d 0 R >> >> >>\nendobj\n",
+        PDF_PAGES, fixed4(buf, page->width), fixed4(buf2, page->height), object + 1, PDF_FONT);
+
+    if (pdf_begin_object(pdf, object + 1) < 0)
+        return -1;
+    out(&pdf->w, "<< /Length %zu >>\nstream\n", page->length);
+    if (fwrite(page->content, 1, page->length, pdf->w.fp) != page->length)
+        pdf->w.error = 1;
+    pdf->w.offset += page->length;
+    out(&pdf->w, "endstream\nendobj\n");
+
+    pdf->n_pages++;
+    return pdf->w.error ? -1 : 0;
+}
+
+int qr_pdf_finish(QrPdf *pdf){
+
+    long start;
+    int ret;
+
+    pdf_begin_object(pdf, PDF_PAGES);
+    out(&pdf->w, "<< /Type /Pages /Count %d /Kids [", pdf->n_pages);
+    for (int i = 0; i < pdf->n_pages; i++)
+        out(&pdf->w, i % 16 == 15 ? " %d 0 R\n" : " %d 0 R", PDF_FONT + 1 + 2 * i);
+    out(&pdf->w, " ] >>\nendobj\n");
+
+    start = pdf->w.offset;
+    out(&pdf->w, "xref\n0 %d\n0000000000 65535 f \n", pdf->n_objects + 1);
+    for (int i = 1; i <= pdf->n_objects; i++)
+        out(&pdf->w, "%010ld 00000 n \n", pdf->xref[i]);
+    out(&pdf->w, "trailer\n<< /Size %d /Root %d 0 R >>\nstartxref\n%ld\n%%%%EOF\n",
+        pdf->n_objects + 1, PDF_CATALOG, start);
+
+    ret = finish(&pdf->w);
+    free(pdf->xref);
+    free(pdf);
+    return ret;
+}
+
+int qr_write_pdf(FILE *fp, const unsigned char *data, int width, const QrRasterOptions *opts){
+
+    QrPdfPage page;
+    QrPdf *pdf;
+    int ret;
+
+    if (qr_pdf_page_render(&page, data, width, opts, NULL, 0) < 0)
+        return -1;
+    pdf = qr_pdf_new(fp);
+    if (pdf == NULL) {
+        qr_pdf_page_clear(&page);
+        return -1;
+    }
+
+    ret = qr_pdf_add_page(pdf, &page);
+    if (qr_pdf_finish(pdf) < 0)
+        ret = -1;
+    qr_pdf_page_clear(&page);
+    return ret;
+}
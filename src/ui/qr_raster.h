@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_QR_RASTER_H
+#define WIHOTSPOT_QR_RASTER_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * QR code output that does not depend on libqrencode or libpng.
+ *
+ * A symbol is given as width * width modules, one byte per module with
+ * the low bit set for a dark module, which is the layout of QRcode.data.
+ *
+ * Raster output is built one packed 1 bit per pixel scanline at a time,
+ * so memory does not grow with the scale. SVG and PDF output draw one
+ * rectangle per horizontal run of dark modules and size the page from
+ * the scale and DPI, so they can be printed at any size.
+ */
+
+typedef enum {
+    QR_FORMAT_PNG,
+    QR_FORMAT_SVG,
+    QR_FORMAT_PDF
+} QrFormat;
+
+typedef struct {
+    int scale;   // pixels per module
+    int margin;  // quiet zone, in modules
+    int dpi;     // pixels per inch, sets the printed size
+} QrRasterOptions;
+
+/** Pixels per side of the rendered symbol, margins included. */
+int qr_raster_side(int width, const QrRasterOptions *opts);
+
+/** Bytes per packed scanline. */
+size_t qr_raster_stride(int width, const QrRasterOptions *opts);
+
+/**
+ * Pack one module row into a scanline of qr_raster_stride() bytes, most
+ * significant bit first. Dark pixels are 0 and light pixels 1, matching
+ * a { dark, light } palette. modules is NULL for a margin row.
+ */
+void qr_raster_row(const unsigned char *modules, int width, const QrRasterOptions *opts,
+                   unsigned char *row);
+
+/**
+ * Pick the output format from the extension of path. Anything that is
+ * not .svg or .pdf is PNG.
+ */
+QrFormat qr_format_from_path(const char *path);
+
+/** Write the symbol as an SVG document. Returns 0, or -1 on a write error. */
+int qr_write_svg(FILE *fp, const unsigned char *data, int width, const QrRasterOptions *opts);
+
+/** Write the symbol as a one page PDF. Returns 0, or -1 on a write error. */
+int qr_write_pdf(FILE *fp, const unsigned char *data, int width, const QrRasterOptions *opts);
+
+/*
+ * Multi page PDF output. Pages are rendered with qr_pdf_page_render(),
+ * which needs no shared state and may run on any thread, then appended
+ * in order with qr_pdf_add_page(). Each page is written out as soon as it
+ * is added, only its offsets are kept until qr_pdf_finish().
+ */
+
+typedef struct QrPdf QrPdf;
+
+typedef struct {
+    char *content;      // content stream, malloc()ed
+    size_t length;
+    long long width;    // page size, in 1/10000 pt
+    long long height;
+} QrPdfPage;
+
+/**
+ * Render the symbol with the given caption lines below it, in Helvetica.
+ * The caption is UTF-8, characters outside Latin-1 print as '?'.
+ * Returns 0, or -1 if out of memory.
+ */
+int qr_pdf_page_render(QrPdfPage *page, const unsigned char *data, int width, const QrRasterOptions *opts,
+                       const char *const *caption, int n_caption);
+
+void qr_pdf_page_clear(QrPdfPage *page);
+
+/** Start a PDF on fp. Returns NULL if out of memory. */
+QrPdf *qr_pdf_new(FILE *fp);
+
+/** Write page to the PDF. Returns 0, or -1 on error. */
+int qr_pdf_add_page(QrPdf *pdf, const QrPdfPage *page);
+
+/**
+ * Write the page tree and cross reference table and free pdf. fp is left
+ * open. Returns 0, or -1 if this or any earlier write failed.
+ */
+int qr_pdf_finish(QrPdf *pdf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WIHOTSPOT_QR_RASTER_H
@@ -30,30 +30,184 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 
+#include <errno.h>
 #include <gtk/gtk.h>
+
 #include "qr_ui.h"
+#include "qrgen.h"
+#include "util.h"
+
+#define QR_SCALE 8
+#define QR_MARGIN 4  // quiet zone, in modules
+#define QR_PAYLOAD_SIZE 512
+
+#define QR_RESPONSE_SAVE 1
 
 static GtkBuilder *builder;
-static GError *error = NULL;
+static GtkDialog *dialog;
+static GtkImage *qr_image;
+
+// payload of the code on display, Save writes this one
+static char current_payload[QR_PAYLOAD_SIZE];
+
+// last rendered code, keyed by its payload and scale
+static gchar *cached_payload;
+static int cached_scale;
+static GdkPixbuf *cached_pixbuf;
+
+/**
+ * Draw the QR modules straight into an RGB pixbuf. Each module row is drawn
+ * once and copied to the other scale - 1 scanlines.
+ */
+static GdkPixbuf *render_qr(const QRcode *qr, int scale){
+
+    int side = (qr->width + QR_MARGIN * 2) * scale;
+    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, side, side);
+    guchar *pixels;
+    int stride;
+
+    if (pixbuf == NULL)
+        return NULL;
+
+    pixels = gdk_pixbuf_get_pixels(pixbuf);
+    stride = gdk_pixbuf_get_rowstride(pixbuf);
+    gdk_pixbuf_fill(pixbuf, 0xffffffff);
+
+    for (int y = 0; y < qr->width; y++) {
+        guchar *row = pixels + (gsize) (QR_MARGIN + y) * scale * stride;
+        const unsigned char *module = qr->data + y * qr->width;
+
+        for (int x = 0; x < qr->width; x++) {
+            if (module[x] & 1)
+                memset(row + (gsize) (QR_MARGIN + x) * scale * 3, 0, (gsize) scale * 3);
+        }
+        for (int yy = 1; yy < scale; yy++)
+            memcpy(row + (gsize) yy * stride, row, (gsize) side * 3);
+    }
+
+    return pixbuf;
+}
+
+static GdkPixbuf *get_qr_pixbuf(const char *payload, int scale){
+
+    QRcode *qr;
+
+    if (cached_pixbuf != NULL && cached_scale == scale && g_strcmp0(cached_payload, payload) == 0)
+        return cached_pixbuf;
+
+    qr = qr_encode(payload);
+    if (qr == NULL)
+        return NULL;
+
+    g_clear_object(&cached_pixbuf);
+    g_free(cached_payload);
+    cached_pixbuf = render_qr(qr, scale);
+    cached_payload = g_strdup(payload);
+    cached_scale = scale;
+    QRcode_free(qr);
+
+    return cached_pixbuf;
+}
 
-void open_qr(GtkWidget *widget, gpointer root,char* image_path) {
+static void init_dialog(GtkWidget *parent){
+
+    GError *error = NULL;
 
     builder = gtk_builder_new();
     //Load ui description from built resource - need to generate compiled source with glib-compile-resource
-    gtk_builder_add_from_resource(builder,"/org/gtk/wihotspot/qr.glade",&error);
+    if (gtk_builder_add_from_resource(builder,"/org/gtk/wihotspot/qr.glade",&error) == 0) {
+        g_printerr("Could not load the QR dialog: %s\n", error->message);
+        g_error_free(error);
+        g_clear_object(&builder);
+        return;
+    }
+
+    dialog = GTK_DIALOG(gtk_builder_get_object(builder, "dialog_qr"));
+    qr_image = (GtkImage *) gtk_builder_get_object(builder, "image_qr");
+
+    // closing only hides it, the next open reuses it
+    g_signal_connect(dialog, "delete-event", G_CALLBACK(gtk_widget_hide_on_delete), NULL);
+
+    if (parent != NULL)
+        gtk_window_set_transient_for(GTK_WINDOW(dialog), GTK_WINDOW(gtk_widget_get_toplevel(parent)));
+}
+
+static void add_filter(GtkFileChooser *chooser, const char *name, const char *pattern){
+
+    GtkFileFilter *filter = gtk_file_filter_new();
+
+    gtk_file_filter_set_name(filter, name);
+    gtk_file_filter_add_pattern(filter, pattern);
+    gtk_file_chooser_add_filter(chooser, filter);
+}
+
+static void save_qr(const char *payload){
+
+    GtkWidget *chooser;
+    char *path;
+
+    chooser = gtk_file_chooser_dialog_new("Save QR code", GTK_WINDOW(dialog), GTK_FILE_CHOOSER_ACTION_SAVE,
+                                          "_Cancel", GTK_RESPONSE_CANCEL, "_Save", GTK_RESPONSE_ACCEPT, NULL);
+    gtk_file_chooser_set_do_overwrite_confirmation(GTK_FILE_CHOOSER(chooser), TRUE);
+    gtk_file_chooser_set_current_name(GTK_FILE_CHOOSER(chooser), "wifi-qr.pdf");
+    add_filter(GTK_FILE_CHOOSER(chooser), "All supported files", "*.[pPsS][dDvVnN][fFgG]");
+    add_filter(GTK_FILE_CHOOSER(chooser), "PDF document", "*.[pP][dD][fF]");
+    add_filter(GTK_FILE_CHOOSER(chooser), "SVG image", "*.[sS][vV][gG]");
+    add_filter(GTK_FILE_CHOOSER(chooser), "PNG image", "*.[pP][nN][gG]");
+
+    if (gtk_dialog_run(GTK_DIALOG(chooser)) == GTK_RESPONSE_ACCEPT) {
+        path = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(chooser));
+        if (qr_to_file(payload, path, &qr_print_options) != 0) {
+            GtkWidget *message = gtk_message_dialog_new(GTK_WINDOW(chooser), GTK_DIALOG_MODAL,
+                                                        GTK_MESSAGE_ERROR, GTK_BUTTONS_CLOSE,
+                                                        "Could not save %s: %s", path, g_strerror(errno));
+            gtk_dialog_run(GTK_DIALOG(message));
+            gtk_widget_destroy(message);
+        }
+        g_free(path);
+    }
+
+    gtk_widget_destroy(chooser);
+}
+
+static int show_payload(const char *ssid, const char *type, const char *password){
+
+    char payload[QR_PAYLOAD_SIZE];
+    GdkPixbuf *pixbuf;
+
+    if (wifi_qr_string(payload, sizeof(payload), ssid, type, password) < 0)
+        return -1;
+
+    pixbuf = get_qr_pixbuf(payload, QR_SCALE);
+    if (pixbuf == NULL)
+        return -1;
+
+    gtk_image_set_from_pixbuf(qr_image, pixbuf);
+    memcpy(current_payload, payload, sizeof(payload));
+
+    return 0;
+}
+
+void open_qr(GtkWidget *widget, gpointer root, const char *ssid, const char *type, const char *password) {
 
-    root = gtk_builder_get_object(builder, "dialog_qr");
+    if (dialog == NULL)
+        init_dialog(widget);
+    if (dialog == NULL)
+        return;
 
-    GtkImage* qr_image = (GtkImage *) gtk_builder_get_object(builder, "image_qr");
+    if (show_payload(ssid, type, password) < 0)
+        return;
 
-    gtk_image_set_from_file(qr_image,image_path);
+    while (gtk_dialog_run(dialog) == QR_RESPONSE_SAVE)
+        save_qr(current_payload);
+    gtk_widget_hide(GTK_WIDGET(dialog));
+}
 
-    GtkDialog* dialog= GTK_DIALOG(root);
-    
-    gtk_dialog_run(GTK_DIALOG(dialog));
+void update_qr(const char *ssid, const char *type, const char *password) {
 
-    gtk_widget_destroy(GTK_WIDGET( dialog));
-    
-    g_signal_connect (dialog, "destroy", G_CALLBACK(gtk_main_quit), NULL);
+    // a hidden dialog is redrawn by the next open_qr()
+    if (dialog == NULL || !gtk_widget_get_visible(GTK_WIDGET(dialog)))
+        return;
 
-}
\ No newline at end of file
+    show_payload(ssid, type, password);
+}
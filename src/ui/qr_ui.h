@@ -6,6 +6,13 @@
 #include <gtk/gtk.h>
 
 
-void open_qr(GtkWidget *widget, gpointer window,char* image_path);
+/**
+ * Show the QR code that joins the given network. The code is rendered in
+ * memory and kept until the credentials change.
+ */
+void open_qr(GtkWidget *widget, gpointer window, const char *ssid, const char *type, const char *password);
+
+/** Redraw the open QR dialog, if any, after the credentials changed. */
+void update_qr(const char *ssid, const char *type, const char *password);
 
 #endif
\ No newline at end of file
@@ -32,106 +32,115 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <qrencode.h>
 #include <errno.h>
 #include <stdlib.h>
-#include <fstream>
-#include <string>
-#include <iostream>
-#include <numeric>
 #include <png.h>
-#include <cstring>
+#include <zlib.h>
 #include "qrgen.h"
 
 
 
 extern "C"{
 
-static int casesensitive = 0;
-static int eightbit = 0;
-static int version = 0;
-static int size = 8;
-static int margin = 5;
-static int dpi = 128;
-static int structured = 0;
-static int rle = 0;
-static int micro = 0;
-static QRecLevel level = QR_ECLEVEL_L;
-static QRencodeMode hint = QR_MODE_8;
 static unsigned int fg_color[4] = {0, 0, 0, 255};
 static unsigned int bg_color[4] = {255, 255, 255, 255};
 
+const QrRasterOptions qr_default_options = {8, 5, 128};
+const QrRasterOptions qr_print_options = {48, 4, 600};
 
-// int main()
-// {
-// const char * line = "The stuff you want to encode";
-//         QRcode *myqrcode;
-//         myqrcode = QRcode_encodeString(line, 4, QR_ECLEVEL_H, QR_MODE_8,1);
-//         writePNG(myqrcode,"filename.png");
-//         QRcode_free(myqrcode);
-// return 0;
-// }
 
-void qr_to_png(const char *qrstring,const char *outfile){
-
-    QRcode *myqrcode;
-        myqrcode = QRcode_encodeString(qrstring, 4, QR_ECLEVEL_H, QR_MODE_8,1);
-        writePNG(myqrcode,outfile);
-        QRcode_free(myqrcode);
+QRcode *qr_encode(const char *qrstring){
+    return QRcode_encodeString(qrstring, 4, QR_ECLEVEL_H, QR_MODE_8, 1);
 }
 
 
+int qr_to_file(const char *qrstring, const char *outfile, const QrRasterOptions *opts){
 
+    QRcode *qrcode;
+    FILE *fp;
+    int ret, saved_errno;
 
-static int writePNG(QRcode *qrcode, const char *outfile)
-{
-    static FILE *fp; // avoid clobbering by setjmp.
-    png_structp png_ptr;
-    png_infop info_ptr;
-    png_colorp palette;
-    png_byte alpha_values[2];
-    unsigned char *row, *p, *q;
-    int x, y, xx, yy, bit;
-    int realwidth;
-
-    realwidth = (qrcode->width + margin * 2) * size;
-    row = (unsigned char *)malloc((realwidth + 7) / 8);
-    if(row == NULL) {
-        fprintf(stderr, "Failed to allocate memory.\n");
-        exit(EXIT_FAILURE);
+    if (opts == NULL)
+        opts = &qr_default_options;
+    if (opts->scale <= 0 || opts->margin < 0 || opts->dpi <= 0) {
+        errno = EINVAL;
+        return -1;
     }
 
-    if(outfile[0] == '-' && outfile[1] == '\0') {
+    qrcode = qr_encode(qrstring);
+    if (qrcode == NULL)
+        return -1;
+
+    if (outfile[0] == '-' && outfile[1] == '\0') {
         fp = stdout;
     } else {
         fp = fopen(outfile, "wb");
-        if(fp == NULL) {
-            fprintf(stderr, "Failed to create file: %s\n", outfile);
-            perror(NULL);
-            exit(EXIT_FAILURE);
+        if (fp == NULL) {
+            QRcode_free(qrcode);
+            return -1;
         }
     }
 
+    switch (qr_format_from_path(outfile)) {
+        case QR_FORMAT_SVG:
+            ret = qr_write_svg(fp, qrcode->data, qrcode->width, opts);
+            break;
+        case QR_FORMAT_PDF:
+            ret = qr_write_pdf(fp, qrcode->data, qrcode->width, opts);
+            break;
+        default:
+            ret = qr_write_png(fp, qrcode, opts);
+            break;
+    }
+
+    saved_errno = errno;
+    if (fp != stdout && fclose(fp) != 0 && ret == 0) {
+        ret = -1;
+        saved_errno = errno;
+    }
+    QRcode_free(qrcode);
+    if (ret != 0 && saved_errno == 0)
+        saved_errno = EIO;
+    errno = saved_errno;
+
+    return ret;
+}
+
+
+int qr_write_png(FILE *fp, const QRcode *qrcode, const QrRasterOptions *opts)
+{
+    png_structp png_ptr;
+    png_infop info_ptr;
+    png_color palette[2];
+    png_byte alpha_values[2];
+    unsigned char *row;
+    int y, yy;
+    int realwidth;
+    png_uint_32 ppm;
+
+    realwidth = qr_raster_side(qrcode->width, opts);
+    // one packed scanline, whatever the scale
+    row = (unsigned char *)malloc(qr_raster_stride(qrcode->width, opts));
+    if(row == NULL)
+        return -1;
+
     png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
     if(png_ptr == NULL) {
-        fprintf(stderr, "Failed to initialize PNG writer.\n");
-        exit(EXIT_FAILURE);
+        free(row);
+        return -1;
     }
 
     info_ptr = png_create_info_struct(png_ptr);
     if(info_ptr == NULL) {
-        fprintf(stderr, "Failed to initialize PNG write.\n");
-        exit(EXIT_FAILURE);
+        png_destroy_write_struct(&png_ptr, NULL);
+        free(row);
+        return -1;
     }
 
     if(setjmp(png_jmpbuf(png_ptr))) {
         png_destroy_write_struct(&png_ptr, &info_ptr);
-        fprintf(stderr, "Failed to write PNG image.\n");
-        exit(EXIT_FAILURE);
+        free(row);
+        return -1;
     }
 
-    palette = (png_colorp) malloc(sizeof(png_color) * 2);
-    if(palette == NULL) {
-        fprintf(stderr, "Failed to allocate memory.\n");
-        exit(EXIT_FAILURE);
-    }
     palette[0].red   = fg_color[0];
     palette[0].green = fg_color[1];
     palette[0].blue  = fg_color[2];
@@ -143,6 +152,11 @@ static int writePNG(QRcode *qrcode, const char *outfile)
     png_set_PLTE(png_ptr, info_ptr, palette, 2);
     png_set_tRNS(png_ptr, info_ptr, alpha_values, 2, NULL);
 
+    // every module row repeats scale times, so the Up filter turns all but
+    // one of them into zeros and run length matching is enough for zlib
+    png_set_filter(png_ptr, 0, PNG_FILTER_UP);
+    png_set_compression_strategy(png_ptr, Z_RLE);
+
     png_init_io(png_ptr, fp);
     png_set_IHDR(png_ptr, info_ptr,
         realwidth, realwidth,
@@ -151,55 +165,38 @@ static int writePNG(QRcode *qrcode, const char *outfile)
         PNG_INTERLACE_NONE,
         PNG_COMPRESSION_TYPE_DEFAULT,
         PNG_FILTER_TYPE_DEFAULT);
-png_set_pHYs(png_ptr, info_ptr,
-        dpi * INCHES_PER_METER,
-        dpi * INCHES_PER_METER,
-        PNG_RESOLUTION_METER);
-png_write_info(png_ptr, info_ptr);
-
-/* top margin */
-memset(row, 0xff, (realwidth + 7) / 8);
-for(y=0; y<margin * size; y++) {
-    png_write_row(png_ptr, row);
-}
+    ppm = (png_uint_32) (opts->dpi * INCHES_PER_METER + 0.5);
+    png_set_pHYs(png_ptr, info_ptr, ppm, ppm, PNG_RESOLUTION_METER);
+    png_write_info(png_ptr, info_ptr);
+
+    /* top margin */
+    qr_raster_row(NULL, qrcode->width, opts, row);
+    for(y=0; y<opts->margin * opts->scale; y++) {
+        png_write_row(png_ptr, row);
+    }
 
-/* data */
-p = qrcode->data;
-for(y=0; y<qrcode->width; y++) {
-    bit = 7;
-    memset(row, 0xff, (realwidth + 7) / 8);
-    q = row;
-    q += margin * size / 8;
-    bit = 7 - (margin * size % 8);
-    for(x=0; x<qrcode->width; x++) {
-        for(xx=0; xx<size; xx++) {
-            *q ^= (*p & 1) << bit;
-            bit--;
-            if(bit < 0) {
-                q++;
-                bit = 7;
-            }
+    /* data, each module row is packed once and written scale times */
+    for(y=0; y<qrcode->width; y++) {
+        qr_raster_row(qrcode->data + y * qrcode->width, qrcode->width, opts, row);
+        for(yy=0; yy<opts->scale; yy++) {
+            png_write_row(png_ptr, row);
         }
-        p++;
     }
-    for(yy=0; yy<size; yy++) {
+
+    /* bottom margin */
+    qr_raster_row(NULL, qrcode->width, opts, row);
+    for(y=0; y<opts->margin * opts->scale; y++) {
         png_write_row(png_ptr, row);
     }
-}
-/* bottom margin */
-memset(row, 0xff, (realwidth + 7) / 8);
-for(y=0; y<margin * size; y++) {
-    png_write_row(png_ptr, row);
-}
 
-png_write_end(png_ptr, info_ptr);
-png_destroy_write_struct(&png_ptr, &info_ptr);
+    png_write_end(png_ptr, info_ptr);
+    png_destroy_write_struct(&png_ptr, &info_ptr);
+    free(row);
 
-fclose(fp);
-free(row);
-free(palette);
+    if (fflush(fp) != 0 || ferror(fp))
+        return -1;
 
-return 0;
+    return 0;
 }
 
 }
\ No newline at end of file
@@ -31,17 +31,38 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef WIHOTSPOT_QRGEN_H
 #define WIHOTSPOT_QRGEN_H
 
+#include <stdio.h>
 #include <qrencode.h>
 
+#include "qr_raster.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define INCHES_PER_METER (100.0/2.54)
 
-static int writePNG(QRcode *qrcode, const char *outfile);
+/** Used when no options are given: 8 pixels per module, 5 module margin, 128 DPI. */
+extern const QrRasterOptions qr_default_options;
+
+/** For printing: 2 mm modules, a version 4 code is about 8 cm wide. */
+extern const QrRasterOptions qr_print_options;
+
+/** Encode qrstring the way every code of the application is encoded. Free with QRcode_free(). */
+QRcode *qr_encode(const char *qrstring);
 
-void qr_to_png(const char *qrstring,const char *outfile);
+/**
+ * Write qrcode as a 1 bit palette PNG. The DPI goes in the pHYs chunk.
+ * Returns 0, or -1 on error.
+ */
+int qr_write_png(FILE *fp, const QRcode *qrcode, const QrRasterOptions *opts);
+
+/**
+ * Encode qrstring and write it to outfile, "-" for stdout, in the format
+ * given by the extension of outfile. opts may be NULL.
+ * Returns 0, or -1 with errno set on error.
+ */
+int qr_to_file(const char *qrstring, const char *outfile, const QrRasterOptions *opts);
 
 #ifdef __cplusplus
 }
@@ -31,115 +31,303 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <iostream>
-#include <fstream>
-#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <string_view>
+#include <fcntl.h>
 #include <pwd.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "read_config.h"
 
-#define CONFIG_KEY_COUNT 30
-#define STRING_MAX_LENGTH 100
 #define BUFSIZE 150
 
-extern "C" {
-
-ConfigValues configValues;
+namespace {
 
-char configs[CONFIG_KEY_COUNT][STRING_MAX_LENGTH];
+/*
+ * Every option create_ap stores, in the order of CONFIG_OPTS, with the
+ * ConfigValues field it maps to and create_ap's default for it.
+ */
+struct ConfigKey {
+    std::string_view name;
+    size_t field;
+    const char *def;
+};
+
+constexpr ConfigKey CONFIG_KEYS[] = {
+        {CHANNEL,          offsetof(ConfigValues, channel),           "default"},
+        {GATEWAY,          offsetof(ConfigValues, gateway),           "192.168.12.1"},
+        {WPA_VERSION,      offsetof(ConfigValues, wpa_version),       "2"},
+        {ETC_HOSTS,        offsetof(ConfigValues, etc_hosts),         "0"},
+        {DHCP_DNS,         offsetof(ConfigValues, dhcp_dns),          "gateway"},
+        {NO_DNS,           offsetof(ConfigValues, no_dns),            "0"},
+        {NO_DNSMASQ,       offsetof(ConfigValues, no_dnsmasq),        "0"},
+        {HIDDEN,           offsetof(ConfigValues, hidden),            "0"},
+        {MAC_FILTER,       offsetof(ConfigValues, mac_filter),        "0"},
+        {MAC_FILTER_ACCEP, offsetof(ConfigValues, accepted_mac_file), "/etc/hostapd/hostapd.accept"},
+        {ISOLATE_CLIENTS,  offsetof(ConfigValues, isolate_clients),   "0"},
+        {SHARE_METHOD,     offsetof(ConfigValues, share_method),      "nat"},
+        {IEEE80211N,       offsetof(ConfigValues, ieee80211n),        "0"},
+        {IEEE80211AC,      offsetof(ConfigValues, ieee80211ac),       "0"},
+        {IEEE80211AX,      offsetof(ConfigValues, ieee80211ax),       "0"},
+        {HT_CAPAB,         offsetof(ConfigValues, ht_capab),          "[HT40+]"},
+        {VHT_CAPAB,        offsetof(ConfigValues, vht_capab),         ""},
+        {DRIVER,           offsetof(ConfigValues, driver),            "nl80211"},
+        {NO_VIRT,          offsetof(ConfigValues, no_virt),           "0"},
+        {COUNTRY,          offsetof(ConfigValues, country),           ""},
+        {FREQ_BAND,        offsetof(ConfigValues, freq),              "default"},
+        {NEW_MACADDR,      offsetof(ConfigValues, mac),               ""},
+        {DAEMONIZE,        offsetof(ConfigValues, daemonize),         "0"},
+        {DAEMON_PIDFILE,   offsetof(ConfigValues, daemon_pidfile),    ""},
+        {DAEMON_LOGFILE,   offsetof(ConfigValues, daemon_logfile),    "/dev/null"},
+        {DNS_LOGFILE,      offsetof(ConfigValues, dns_logfile),       ""},
+        {NO_HAVEGED,       offsetof(ConfigValues, no_haveged),        "0"},
+        {WIFI_IFACE,       offsetof(ConfigValues, iface_wifi),        ""},
+        {INTERNET_IFACE,   offsetof(ConfigValues, iface_inet),        ""},
+        {SSID,             offsetof(ConfigValues, ssid),              ""},
+        {PASSPHRASE,       offsetof(ConfigValues, pass),              ""},
+        {USE_PSK,          offsetof(ConfigValues, use_psk),           "0"},
+        {ADDN_HOSTS,       offsetof(ConfigValues, addn_hosts),        ""},
+        {DHCP_HOSTS,       offsetof(ConfigValues, dhcp_hosts),        ""},
+        {ROTATE_PASSPHRASE, offsetof(ConfigValues, rotate_passphrase), "never"},
+        {TRAFFIC_SAMPLE_MS, offsetof(ConfigValues, traffic_sample_ms), "1000"},
+};
+
+constexpr int KEY_COUNT = sizeof(CONFIG_KEYS) / sizeof(CONFIG_KEYS[0]);
+constexpr int SLOT_BITS = 7;
+constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+
+constexpr uint32_t fnv1a(std::string_view key){
+    uint32_t h = 2166136261u;
+    for (char c : key) {
+        h ^= (unsigned char) c;
+        h *= 16777619u;
+    }
+    return h;
+}
 
-int read_config_file() {
-    // std::ifstream is RAII, i.e. no need to call close
-    std::ifstream cFile(get_config_file(CONFIG_FILE_NAME));
-    if (cFile.is_open()) {
-        std::string line;
-
-        int i=0;
-        while (getline(cFile, line)) {
-            auto delimiterPos = line.find('=');
-            if (!(line.find("SSID") < delimiterPos) && !(line.find("PASSPHRASE") < delimiterPos)) {
-                line.erase(std::remove_if(line.begin(), line.end(), isspace),
-                           line.end());
-            }
-            if (line[0] == '#' || line.empty())
-                continue;
-            delimiterPos = line.find('='); //check again in case it changed
-            auto name = line.substr(0, delimiterPos);
-            auto value = line.substr(delimiterPos + 1);
-
-            strcpy(configs[i],value.c_str());
-            setConfigValues(name.c_str(),configs[i]);
-            //std::cout << name << " " << value << '\n';
-            ++i;
-        }
+// Fibonacci hashing of the seeded FNV-1a hash picks the top bits
+constexpr uint32_t key_hash(std::string_view key, uint32_t seed){
+    return ((fnv1a(key) ^ seed) * 2654435761u) >> (32 - SLOT_BITS);
+}
 
-    } else {
-        std::cerr << "Couldn't open config file for reading.\n";
-        return READ_CONFIG_FILE_FAIL;
+constexpr bool is_perfect(uint32_t seed){
+    bool used[SLOTS] = {};
+    for (const auto &key : CONFIG_KEYS) {
+        uint32_t slot = key_hash(key.name, seed);
+        if (used[slot])
+            return false;
+        used[slot] = true;
     }
+    return true;
+}
 
-    return READ_CONFIG_FILE_SUCCESS;
+constexpr uint32_t find_seed(){
+    uint32_t seed = 0;
+    while (!is_perfect(seed))
+        seed++;
+    return seed;
 }
 
-ConfigValues* getConfigValues(){
-    return &configValues;
+// Found by the compiler, so adding a key can not introduce a collision
+constexpr uint32_t SEED = find_seed();
+
+constexpr std::array<int8_t, SLOTS> build_slots(){
+    std::array<int8_t, SLOTS> slots{};
+    for (auto &slot : slots)
+        slot = -1;
+    for (int i = 0; i < KEY_COUNT; i++)
+        slots[key_hash(CONFIG_KEYS[i].name, SEED)] = (int8_t) i;
+    return slots;
 }
 
+constexpr std::array<int8_t, SLOTS> KEY_SLOTS = build_slots();
 
-static void setConfigValues(const char * key, char *value){
+static_assert(KEY_COUNT < (int) SLOTS, "Too many config keys for the hash table");
 
-    if( !strcmp ( SSID, key ))
-        configValues.ssid = value;
+int find_key(std::string_view key){
+    int i = KEY_SLOTS[key_hash(key, SEED)];
+    return (i >= 0 && CONFIG_KEYS[i].name == key) ? i : -1;
+}
 
-    if( !strcmp ( PASSPHRASE, key ))
-        configValues.pass = value;
+constexpr std::string_view SPACE = " \t\r\f\v";
 
-    if( !strcmp ( WIFI_IFACE, key ))
-        configValues.iface_wifi = value;
+std::string_view trim(std::string_view s){
+    size_t start = s.find_first_not_of(SPACE);
+    if (start == std::string_view::npos)
+        return {};
+    return s.substr(start, s.find_last_not_of(SPACE) - start + 1);
+}
 
-    if( !strcmp ( INTERNET_IFACE, key ))
-        configValues.iface_inet = value;
+char *&field(ConfigValues *cv, int key){
+    return *reinterpret_cast<char **>(reinterpret_cast<char *>(cv) + CONFIG_KEYS[key].field);
+}
 
-    if( !strcmp ( HIDDEN, key ))
-        configValues.hidden = value;
+const char *field(const ConfigValues *cv, int key){
+    return *reinterpret_cast<char *const *>(reinterpret_cast<const char *>(cv) + CONFIG_KEYS[key].field);
+}
 
-    if( !strcmp ( NO_HAVEGED, key ))
-        configValues.no_haveged = value;
+/**
+ * Collect a view of the value of every known key. Later lines win, like
+ * they do when create_ap sources the file.
+ */
+void parse(std::string_view text, std::string_view *values){
+
+    while (!text.empty()) {
+        size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+
+        size_t eq = line.find('=');
+        if (eq == std::string_view::npos)
+            continue;
+
+        std::string_view name = trim(line.substr(0, eq));
+        if (name.empty() || name[0] == '#')
+            continue;
+
+        int key = find_key(name);
+        if (key < 0)
+            continue;
+
+        std::string_view value = line.substr(eq + 1);
+        // Spaces are part of the SSID and passphrase
+        if (name == SSID || name == PASSPHRASE) {
+            if (!value.empty() && value.back() == '\r')
+                value.remove_suffix(1);
+        } else {
+            value = trim(value);
+        }
+        values[key] = value;
+    }
+}
 
-    if( !strcmp ( NO_VIRT, key ))
-        configValues.no_virt = value;
+}
 
-    if( !strcmp ( NEW_MACADDR, key ))
-        configValues.mac = value;
+extern "C" {
 
-    if( !strcmp ( CHANNEL, key ))
-        configValues.channel = value;
+ConfigValues configValues;
 
-    if( !strcmp ( FREQ_BAND, key ))
-        configValues.freq = value;
+/**
+ * Load a config file into cv. The file is mapped and parsed in one pass;
+ * the values that were found are then copied into a single arena that
+ * cv owns, and the rest point to create_ap's defaults, so every field is
+ * set. Free it with config_values_free().
+ */
+int config_values_load(const char *path, ConfigValues *cv){
 
-    if( !strcmp ( USE_PSK, key ))
-        configValues.use_psk = value;
+    std::string_view values[KEY_COUNT] = {};
+    bool found[KEY_COUNT] = {};
+    struct stat st;
+    void *map = nullptr;
+    size_t arena_size = 0;
+    int fd;
 
-    if( !strcmp ( MAC_FILTER, key ))
-        configValues.mac_filter = value;
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return READ_CONFIG_FILE_FAIL;
 
-    if( !strcmp ( MAC_FILTER_ACCEP, key ))
-        configValues.accepted_mac_file = value;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        return READ_CONFIG_FILE_FAIL;
+    }
 
-    if( !strcmp ( IEEE80211N, key ))
-        configValues.ieee80211n = value;
+    if (st.st_size > 0) {
+        map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            return READ_CONFIG_FILE_FAIL;
+        }
+        parse(std::string_view(static_cast<const char *>(map), st.st_size), values);
+    }
+    close(fd);
 
-    if( !strcmp ( IEEE80211AC, key ))
-        configValues.ieee80211ac = value;
+    for (int i = 0; i < KEY_COUNT; i++) {
+        found[i] = values[i].data() != nullptr;
+        if (found[i])
+            arena_size += values[i].size() + 1;
+    }
 
-    if( !strcmp ( IEEE80211AX, key ))
-        configValues.ieee80211ax = value;
-        
-    if( !strcmp ( GATEWAY, key ))
-        configValues.gateway = value;
+    memset(cv, 0, sizeof(*cv));
+    cv->arena = static_cast<char *>(malloc(arena_size != 0 ? arena_size : 1));
+    if (cv->arena == nullptr) {
+        if (map != nullptr)
+            munmap(map, st.st_size);
+        return READ_CONFIG_FILE_FAIL;
+    }
+
+    char *p = cv->arena;
+    for (int i = 0; i < KEY_COUNT; i++) {
+        if (!found[i]) {
+            field(cv, i) = const_cast<char *>(CONFIG_KEYS[i].def);
+            continue;
+        }
+        memcpy(p, values[i].data(), values[i].size());
+        p[values[i].size()] = '\0';
+        field(cv, i) = p;
+        p += values[i].size() + 1;
+    }
+
+    if (map != nullptr)
+        munmap(map, st.st_size);
+
+    return READ_CONFIG_FILE_SUCCESS;
+}
+
+void config_values_free(ConfigValues *cv){
+    free(cv->arena);
+    memset(cv, 0, sizeof(*cv));
+}
+
+int read_config_file() {
+    return read_config_file_path(get_config_file(CONFIG_FILE_NAME));
+}
+
+int read_config_file_path(const char *path) {
+
+    ConfigValues cv;
+
+    if (config_values_load(path, &cv) != READ_CONFIG_FILE_SUCCESS) {
+        std::cerr << "Couldn't open config file for reading.\n";
+        return READ_CONFIG_FILE_FAIL;
+    }
+
+    config_values_free(&configValues);
+    configValues = cv;
+    return READ_CONFIG_FILE_SUCCESS;
+}
+
+ConfigValues* getConfigValues(){
+    return &configValues;
+}
+
+/**
+ * Serialize cv into buf in the format create_ap --mkconfig writes, so the
+ * config can be saved without running create_ap. Fields left NULL get
+ * create_ap's defaults. Returns the length, or -1 if buf is too small or
+ * a value would break the line based format.
+ */
+int serialize_config_values(const ConfigValues* cv, char* buf, size_t size){
+
+    size_t len=0;
+
+    for(int i=0;i<KEY_COUNT;i++){
+        const char* value=field(cv,i)!=nullptr ? field(cv,i) : CONFIG_KEYS[i].def;
+
+        if(strpbrk(value,"\n\r")!=nullptr)
+            return -1;
+
+        int n=snprintf(buf+len,size-len,"%.*s=%s\n",(int)CONFIG_KEYS[i].name.size(),CONFIG_KEYS[i].name.data(),value);
+        if(n<0 || (size_t)n>=size-len)
+            return -1;
+        len+=n;
+    }
 
+    return (int)len;
 }
 
 
@@ -67,11 +67,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SSID             "SSID"
 #define PASSPHRASE       "PASSPHRASE"
 #define USE_PSK          "USE_PSK"
+#define DAEMON_PIDFILE   "DAEMON_PIDFILE"
+#define DAEMON_LOGFILE   "DAEMON_LOGFILE"
+#define DNS_LOGFILE      "DNS_LOGFILE"
+#define ADDN_HOSTS       "ADDN_HOSTS"
+#define DHCP_HOSTS       "DHCP_HOSTS"
+#define ROTATE_PASSPHRASE "ROTATE_PASSPHRASE"
+#define TRAFFIC_SAMPLE_MS "TRAFFIC_SAMPLE_MS"
 
 
 
 #define CONFIG_FILE_NAME "/etc/create_ap.conf"
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -95,12 +104,36 @@ typedef struct{
     char *ieee80211ax;
     char *no_haveged;
     char *gateway;
+    char *wpa_version;
+    char *etc_hosts;
+    char *dhcp_dns;
+    char *no_dns;
+    char *no_dnsmasq;
+    char *isolate_clients;
+    char *share_method;
+    char *ht_capab;
+    char *vht_capab;
+    char *driver;
+    char *country;
+    char *daemonize;
+    char *daemon_pidfile;
+    char *daemon_logfile;
+    char *dns_logfile;
+    char *addn_hosts;
+    char *dhcp_hosts;
+    char *rotate_passphrase;    // never, hourly, daily or weekly, create_ap rotates the passphrase
+    char *traffic_sample_ms;    // interval of the throughput graphs, only used by the GUI
+
+    char *arena;        // owns the loaded values, see config_values_load()
 } ConfigValues;
 
 
 int read_config_file();
-static void setConfigValues(const char * key, char *value);
+int read_config_file_path(const char *path);
 ConfigValues* getConfigValues(void);
+int config_values_load(const char *path, ConfigValues *cv);
+void config_values_free(ConfigValues *cv);
+int serialize_config_values(const ConfigValues* cv, char* buf, size_t size);
 const char *get_config_file(const char* file);
 
 #ifdef __cplusplus
@@ -0,0 +1,229 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <net/if.h>
+#include <linux/nl80211.h>
+
+#include "netlink.h"
+#include "station.h"
+
+static StationInfo *stations;
+static int station_n;
+static int station_cap;
+
+static int genl_fd = -1;
+static int nl80211_id = -1;
+
+static StationInfo *add_station(void){
+
+    if (station_n == station_cap) {
+        int cap = station_cap ? station_cap * 2 : 32;
+        StationInfo *n = realloc(stations, cap * sizeof(StationInfo));
+        if (n == NULL)
+            return NULL;
+        stations = n;
+        station_cap = cap;
+    }
+
+    memset(&stations[station_n], 0, sizeof(StationInfo));
+    return &stations[station_n++];
+}
+
+static uint32_t parse_bitrate(const struct nlattr *attr){
+
+    struct nlattr *rate[NL80211_RATE_INFO_MAX + 1];
+
+    netlink_parse_nested(rate, NL80211_RATE_INFO_MAX, attr);
+
+    if (rate[NL80211_RATE_INFO_BITRATE32])
+        return netlink_attr_u32(rate[NL80211_RATE_INFO_BITRATE32]);
+    if (rate[NL80211_RATE_INFO_BITRATE])
+        return netlink_attr_u16(rate[NL80211_RATE_INFO_BITRATE]);
+    return 0;
+}
+
+/**
+ * Fill st from a station message. Returns -1 if it has no station.
+ */
+static int parse_station(struct nlmsghdr *nlh, StationInfo *st){
+
+    struct nlattr *tb[NL80211_ATTR_MAX + 1];
+    struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+    unsigned char *mac;
+    int len;
+    void *attrs = genl_msg_attrs(nlh, &len);
+
+    netlink_parse_attrs(tb, NL80211_ATTR_MAX, attrs, len);
+
+    if (tb[NL80211_ATTR_MAC] == NULL || tb[NL80211_ATTR_STA_INFO] == NULL
+        || netlink_attr_len(tb[NL80211_ATTR_MAC]) != 6)
+        return -1;
+
+    memset(st, 0, sizeof(StationInfo));
+
+    mac = netlink_attr_data(tb[NL80211_ATTR_MAC]);
+    memcpy(st->mac, mac, 6);
+    snprintf(st->mac_str, sizeof(st->mac_str), "%02x:%02x:%02x:%02x:%02x:%02x",
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+    netlink_parse_nested(sinfo, NL80211_STA_INFO_MAX, tb[NL80211_ATTR_STA_INFO]);
+
+    // Prefer the 64 bit byte counters, the 32 bit ones wrap at 4 GiB
+    if (sinfo[NL80211_STA_INFO_RX_BYTES64])
+        st->rx_bytes = netlink_attr_u64(sinfo[NL80211_STA_INFO_RX_BYTES64]);
+    else if (sinfo[NL80211_STA_INFO_RX_BYTES])
+        st->rx_bytes = netlink_attr_u32(sinfo[NL80211_STA_INFO_RX_BYTES]);
+
+    if (sinfo[NL80211_STA_INFO_TX_BYTES64])
+        st->tx_bytes = netlink_attr_u64(sinfo[NL80211_STA_INFO_TX_BYTES64]);
+    else if (sinfo[NL80211_STA_INFO_TX_BYTES])
+        st->tx_bytes = netlink_attr_u32(sinfo[NL80211_STA_INFO_TX_BYTES]);
+
+    if (sinfo[NL80211_STA_INFO_RX_PACKETS])
+        st->rx_packets = netlink_attr_u32(sinfo[NL80211_STA_INFO_RX_PACKETS]);
+    if (sinfo[NL80211_STA_INFO_TX_PACKETS])
+        st->tx_packets = netlink_attr_u32(sinfo[NL80211_STA_INFO_TX_PACKETS]);
+    if (sinfo[NL80211_STA_INFO_TX_RETRIES])
+        st->tx_retries = netlink_attr_u32(sinfo[NL80211_STA_INFO_TX_RETRIES]);
+    if (sinfo[NL80211_STA_INFO_TX_FAILED])
+        st->tx_failed = netlink_attr_u32(sinfo[NL80211_STA_INFO_TX_FAILED]);
+    if (sinfo[NL80211_STA_INFO_INACTIVE_TIME])
+        st->inactive_time = netlink_attr_u32(sinfo[NL80211_STA_INFO_INACTIVE_TIME]);
+    if (sinfo[NL80211_STA_INFO_CONNECTED_TIME])
+        st->connected_time = netlink_attr_u32(sinfo[NL80211_STA_INFO_CONNECTED_TIME]);
+
+    if (sinfo[NL80211_STA_INFO_SIGNAL]) {
+        st->has_signal = 1;
+        st->signal = (int8_t) netlink_attr_u8(sinfo[NL80211_STA_INFO_SIGNAL]);
+    }
+
+    if (sinfo[NL80211_STA_INFO_TX_BITRATE])
+        st->tx_bitrate = parse_bitrate(sinfo[NL80211_STA_INFO_TX_BITRATE]);
+
+    return 0;
+}
+
+static int station_dump_cb(struct nlmsghdr *nlh, void *arg){
+
+    StationInfo st;
+    StationInfo *n;
+
+    if (parse_station(nlh, &st) == 0 && (n = add_station()) != NULL)
+        *n = st;
+
+    return 0;
+}
+
+struct station_query {
+    StationInfo *st;
+    int found;
+};
+
+static int station_query_cb(struct nlmsghdr *nlh, void *arg){
+
+    struct station_query *q = arg;
+
+    if (parse_station(nlh, q->st) == 0)
+        q->found = 1;
+
+    return 0;
+}
+
+/**
+ * Start a GET_STATION request for ifname. Returns -1 if nl80211 is not
+ * there.
+ */
+static int station_request(char *buf, size_t size, const char *ifname, uint16_t flags){
+
+    struct nlmsghdr *nlh = (struct nlmsghdr *) buf;
+    uint32_t index = if_nametoindex(ifname);
+
+    if (index == 0)
+        return -1;
+
+    if (genl_fd < 0 && (genl_fd = netlink_open(NETLINK_GENERIC)) < 0)
+        return -1;
+
+    if (nl80211_id < 0 && (nl80211_id = genl_family_id(genl_fd, NL80211_GENL_NAME)) < 0)
+        return -1;
+
+    genl_msg_init(nlh, nl80211_id, NL80211_CMD_GET_STATION, flags);
+    netlink_put_attr(nlh, size, NL80211_ATTR_IFINDEX, &index, sizeof(index));
+    return 0;
+}
+
+/**
+ * Replace the station table with the stations associated to ifname.
+ * Returns 0 on success, -1 if the dump could not be done.
+ */
+int station_dump(const char *ifname){
+
+    char buf[64];
+
+    station_n = 0;
+
+    if (station_request(buf, sizeof(buf), ifname, NLM_F_DUMP) < 0)
+        return -1;
+
+    return netlink_request(genl_fd, (struct nlmsghdr *) buf, station_dump_cb, NULL) < 0 ? -1 : 0;
+}
+
+/**
+ * Read the station mac of ifname into st, leaving the station table alone.
+ * Returns 0 on success, -1 if it is not associated or could not be read.
+ */
+int station_query(const char *ifname, const unsigned char *mac, StationInfo *st){
+
+    char buf[64];
+    struct nlmsghdr *nlh = (struct nlmsghdr *) buf;
+    struct station_query q = {st, 0};
+
+    if (station_request(buf, sizeof(buf), ifname, 0) < 0)
+        return -1;
+
+    netlink_put_attr(nlh, sizeof(buf), NL80211_ATTR_MAC, mac, 6);
+
+    if (netlink_request(genl_fd, nlh, station_query_cb, &q) < 0 || !q.found)
+        return -1;
+
+    return 0;
+}
+
+int station_count(void){
+    return station_n;
+}
+
+const StationInfo *station_get(int i){
+
+    if (i < 0 || i >= station_n)
+        return NULL;
+
+    return &stations[i];
+}
@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_STATION_H
+#define WIHOTSPOT_STATION_H
+
+#include <stdint.h>
+
+/*
+ * Stations associated to an access point interface, read with an nl80211
+ * station dump, or one at a time with station_query().
+ */
+
+typedef struct {
+    unsigned char mac[6];
+    char mac_str[18];
+
+    uint64_t rx_bytes;
+    uint64_t tx_bytes;
+    uint32_t rx_packets;
+    uint32_t tx_packets;
+    uint32_t tx_retries;
+    uint32_t tx_failed;
+    int has_signal;
+    int signal;                     // dBm
+    uint32_t tx_bitrate;            // 100 kbit/s, 0 if unknown
+    uint32_t inactive_time;         // ms
+    uint32_t connected_time;        // s
+} StationInfo;
+
+int station_dump(const char *ifname);
+int station_query(const char *ifname, const unsigned char *mac, StationInfo *st);
+
+int station_count(void);
+const StationInfo *station_get(int i);
+
+#endif //WIHOTSPOT_STATION_H
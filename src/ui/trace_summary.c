@@ -0,0 +1,361 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace_summary.h"
+
+// events read before the nested ones are dropped
+#define MAX_EVENTS 256
+#define MAX_DEPTH 16
+#define NUMBER_MAX_LEN 32
+
+typedef struct {
+    const char *p;
+    const char *end;
+} Scanner;
+
+static void skip_ws(Scanner *s) {
+
+    while (s->p < s->end && strchr(" \t\r\n", *s->p) != NULL)
+        s->p++;
+}
+
+static int expect(Scanner *s, char c) {
+
+    skip_ws(s);
+    if (s->p >= s->end || *s->p != c)
+        return -1;
+    s->p++;
+    return 0;
+}
+
+/**
+ * Read a string into out, which may be NULL to skip it. Strings that do
+ * not fit are cut, characters escaped as \u are stored as '?'.
+ */
+static int parse_string(Scanner *s, char *out, size_t size) {
+
+    size_t n = 0;
+
+    if (expect(s, '"') < 0)
+        return -1;
+
+    while (s->p < s->end && *s->p != '"') {
+        char c = *s->p++;
+
+        if (c == '\\') {
+            if (s->p >= s->end)
+                return -1;
+            c = *s->p++;
+            switch (c) {
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                case 'u':
+                    if (s->end - s->p < 4)
+                        return -1;
+                    s->p += 4;
+                    c = '?';
+                    break;
+                case '"':
+                case '\\':
+                case '/':
+                    break;
+                default:
+                    return -1;
+            }
+        }
+        if (out != NULL && n + 1 < size)
+            out[n++] = c;
+    }
+    if (s->p >= s->end)
+        return -1;
+    s->p++;
+
+    if (out != NULL && size > 0)
+        out[n] = '\0';
+    return 0;
+}
+
+static int parse_number(Scanner *s, double *out) {
+
+    char buf[NUMBER_MAX_LEN];
+    size_t n = 0;
+    char *end;
+
+    skip_ws(s);
+    while (s->p + n < s->end && n < sizeof(buf) - 1 && strchr("+-0123456789.eE", s->p[n]) != NULL) {
+        buf[n] = s->p[n];
+        n++;
+    }
+    buf[n] = '\0';
+
+    *out = strtod(buf, &end);
+    if (n == 0 || *end != '\0')
+        return -1;
+    s->p += n;
+    return 0;
+}
+
+static int skip_value(Scanner *s, int depth) {
+
+    double number;
+
+    skip_ws(s);
+    if (s->p >= s->end || depth > MAX_DEPTH)
+        return -1;
+
+    switch (*s->p) {
+        case '"':
+            return parse_string(s, NULL, 0);
+        case '{':
+        case '[': {
+            char close = *s->p == '{' ? '}' : ']';
+
+            s->p++;
+            skip_ws(s);
+            if (s->p < s->end && *s->p == close) {
+                s->p++;
+                return 0;
+            }
+            for (;;) {
+                if (close == '}' && (parse_string(s, NULL, 0) < 0 || expect(s, ':') < 0))
+                    return -1;
+                if (skip_value(s, depth + 1) < 0)
+                    return -1;
+                skip_ws(s);
+                if (s->p < s->end && *s->p == ',') {
+                    s->p++;
+                    continue;
+                }
+                return expect(s, close);
+            }
+        }
+        case 't':
+        case 'f':
+        case 'n': {
+            static const char *const words[] = {"true", "false", "null"};
+
+            for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+                size_t len = strlen(words[i]);
+
+                if ((size_t) (s->end - s->p) >= len && strncmp(s->p, words[i], len) == 0) {
+                    s->p += len;
+                    return 0;
+                }
+            }
+            return -1;
+        }
+        default:
+            return parse_number(s, &number);
+    }
+}
+
+static long long round_us(double us) {
+
+    return (long long) (us < 0 ? us - 0.5 : us + 0.5);
+}
+
+/**
+ * Read one event object. Returns 1 if it is a complete event of category
+ * cat, 0 for any other event, or -1 on a syntax error.
+ */
+static int parse_event(Scanner *s, const char *cat, TracePhase *phase) {
+
+    char key[16];
+    char value[TRACE_PHASE_NAME_LEN];
+    int complete = 0, matches = cat == NULL, has_ts = 0;
+    double number;
+
+    phase->name[0] = '\0';
+    phase->dur = 0;
+
+    if (expect(s, '{') < 0)
+        return -1;
+    skip_ws(s);
+    if (s->p < s->end && *s->p == '}') {
+        s->p++;
+        return 0;
+    }
+
+    for (;;) {
+        if (parse_string(s, key, sizeof(key)) < 0 || expect(s, ':') < 0)
+            return -1;
+
+        if (strcmp(key, "name") == 0) {
+            if (parse_string(s, phase->name, sizeof(phase->name)) < 0)
+                return -1;
+        } else if (strcmp(key, "cat") == 0 || strcmp(key, "ph") == 0) {
+            if (parse_string(s, value, sizeof(value)) < 0)
+                return -1;
+            if (key[0] == 'c')
+                matches = cat == NULL || strcmp(value, cat) == 0;
+            else
+                complete = strcmp(value, "X") == 0;
+        } else if (strcmp(key, "ts") == 0 || strcmp(key, "dur") == 0) {
+            if (parse_number(s, &number) < 0)
+                return -1;
+            if (key[0] == 't') {
+                phase->ts = round_us(number);
+                has_ts = 1;
+            } else {
+                phase->dur = number > 0 ? round_us(number) : 0;
+            }
+        } else if (skip_value(s, 1) < 0) {
+            return -1;
+        }
+
+        skip_ws(s);
+        if (s->p < s->end && *s->p == ',') {
+            s->p++;
+            continue;
+        }
+        if (expect(s, '}') < 0)
+            return -1;
+        return complete && matches && has_ts;
+    }
+}
+
+/** Whether b lies inside a, a phase that is identical counts once. */
+static int is_nested(const TracePhase *events, int a, int b) {
+
+    long long a_end = events[a].ts + events[a].dur;
+    long long b_end = events[b].ts + events[b].dur;
+
+    if (a == b || events[a].ts > events[b].ts || a_end < b_end)
+        return 0;
+
+    // create_ap writes a phase after the ones it contains
+    return events[a].dur > events[b].dur || a > b;
+}
+
+static int compare_phases(const void *a, const void *b) {
+
+    const TracePhase *pa = a, *pb = b;
+
+    return (pa->ts > pb->ts) - (pa->ts < pb->ts);
+}
+
+int trace_summary_parse(const char *json, size_t len, const char *cat, TraceSummary *summary) {
+
+    TracePhase events[MAX_EVENTS];
+    Scanner s = {json, json + len};
+    char key[16];
+    int n = 0;
+
+    memset(summary, 0, sizeof(*summary));
+
+    // an object with a "traceEvents" array, or just the array
+    skip_ws(&s);
+    if (s.p < s.end && *s.p == '{') {
+        s.p++;
+        for (;;) {
+            if (parse_string(&s, key, sizeof(key)) < 0 || expect(&s, ':') < 0)
+                return -1;
+            if (strcmp(key, "traceEvents") == 0)
+                break;
+            if (skip_value(&s, 1) < 0 || expect(&s, ',') < 0)
+                return -1;
+        }
+    }
+    if (expect(&s, '[') < 0)
+        return -1;
+    skip_ws(&s);
+    if (s.p < s.end && *s.p == ']') {
+        s.p++;
+    } else {
+        for (;;) {
+            TracePhase phase;
+            int r = parse_event(&s, cat, &phase);
+
+            if (r < 0)
+                return -1;
+            if (r > 0 && n < MAX_EVENTS)
+                events[n++] = phase;
+
+            skip_ws(&s);
+            if (s.p < s.end && *s.p == ',') {
+                s.p++;
+                continue;
+            }
+            if (expect(&s, ']') < 0)
+                return -1;
+            break;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        int nested = 0;
+
+        for (int j = 0; j < n && !nested; j++)
+            nested = is_nested(events, j, i);
+
+        if (events[i].ts + events[i].dur > summary->total)
+            summary->total = events[i].ts + events[i].dur;
+        if (!nested && summary->n_phases < TRACE_SUMMARY_MAX_PHASES)
+            summary->phases[summary->n_phases++] = events[i];
+    }
+
+    qsort(summary->phases, summary->n_phases, sizeof(TracePhase), compare_phases);
+
+    return summary->n_phases;
+}
+
+int trace_summary_format(const TraceSummary *summary, char *buf, size_t size) {
+
+    size_t n = 0;
+    long long other = summary->total;
+    int r;
+
+    if (size == 0)
+        return -1;
+    buf[0] = '\0';
+
+    for (int i = 0; i <= summary->n_phases; i++) {
+        if (i < summary->n_phases) {
+            const TracePhase *phase = &summary->phases[i];
+
+            other -= phase->dur;
+            r = snprintf(buf + n, size - n, "%s%s: %.2f s", n > 0 ? "\n" : "", phase->name, phase->dur / 1e6);
+        } else if (other >= 5000) {
+            // less would print as 0.00 s
+            r = snprintf(buf + n, size - n, "%sother: %.2f s", n > 0 ? "\n" : "", other / 1e6);
+        } else {
+            break;
+        }
+        if (r < 0 || (size_t) r >= size - n)
+            return -1;
+        n += r;
+    }
+
+    return (int) n;
+}
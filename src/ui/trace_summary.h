@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_TRACE_SUMMARY_H
+#define WIHOTSPOT_TRACE_SUMMARY_H
+
+#include <stddef.h>
+
+/*
+ * Where the time of a start went, from the trace create_ap --trace writes.
+ *
+ * The trace is Chrome trace event JSON, either an object with a
+ * "traceEvents" array or the bare array. Only complete events ("ph":"X")
+ * of one category are read. Phases that lie inside another one, like the
+ * NetworkManager wait inside the virtual interface setup, are left out, so
+ * the rest add up to the time create_ap spent, minus what it did between
+ * phases.
+ */
+
+#define TRACE_SUMMARY_MAX_PHASES 32
+#define TRACE_PHASE_NAME_LEN 32
+
+typedef struct {
+    char name[TRACE_PHASE_NAME_LEN];
+    long long ts;   // microseconds since create_ap started
+    long long dur;  // microseconds
+} TracePhase;
+
+typedef struct {
+    long long total;  // end of the last phase, in microseconds
+    int n_phases;
+    TracePhase phases[TRACE_SUMMARY_MAX_PHASES];  // in start order
+} TraceSummary;
+
+/**
+ * Read the top level phases of category cat, or of any category if cat is
+ * NULL. Returns their number, or -1 if json is not a trace.
+ */
+int trace_summary_parse(const char *json, size_t len, const char *cat, TraceSummary *summary);
+
+/**
+ * One "<phase>: <seconds> s" line per phase, and an "other" line for the
+ * time between them. Returns  the length, or -1 if buf is too small.
+ */
+int trace_summary_format(const TraceSummary *summary, char *buf, size_t size);
+
+#endif //WIHOTSPOT_TRACE_SUMMARY_H
@@ -0,0 +1,325 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <net/if.h>
+
+#include "traffic.h"
+
+#define MIN_CLIENTS 16
+
+typedef struct {
+    char name[IF_NAMESIZE];
+    int rx_fd;
+    int tx_fd;
+    TrafficHistory history;
+} IfaceTraffic;
+
+typedef struct {
+    unsigned char mac[6];
+    uint32_t seen;
+    TrafficHistory history;
+} ClientTraffic;
+
+struct TrafficMonitor {
+    IfaceTraffic ifaces[TRAFFIC_IFACE_COUNT];
+
+    ClientTraffic *clients;     // sorted by MAC
+    int count;
+    int cap;
+    uint32_t generation;
+};
+
+/**
+ * Sampling interval in ms for a TRAFFIC_SAMPLE_MS value. Values that are
+ * not a number in range get the default.
+ */
+unsigned int traffic_sample_interval(const char *value){
+
+    char *end;
+    unsigned long ms;
+
+    if (value == NULL || *value == '\0')
+        return TRAFFIC_SAMPLE_MS_DEFAULT;
+
+    errno = 0;
+    ms = strtoul(value, &end, 10);
+    if (errno != 0 || *end != '\0' || ms < TRAFFIC_SAMPLE_MS_MIN || ms > TRAFFIC_SAMPLE_MS_MAX)
+        return TRAFFIC_SAMPLE_MS_DEFAULT;
+
+    return (unsigned int) ms;
+}
+
+void traffic_history_reset(TrafficHistory *h){
+    memset(h, 0, sizeof(*h));
+}
+
+/**
+ * Add a counter sample. Returns 1 if a rate was recorded, 0 if the sample
+ * only (re)started the history.
+ */
+int traffic_history_push(TrafficHistory *h, uint64_t rx_bytes, uint64_t tx_bytes, int64_t now){
+
+    int recorded = 0;
+
+    if (h->primed && now > h->last_time && rx_bytes >= h->last_rx && tx_bytes >= h->last_tx) {
+        float secs = (float) (now - h->last_time) / 1e6f;
+
+        h->rx[h->head] = (float) (rx_bytes - h->last_rx) / secs;
+        h->tx[h->head] = (float) (tx_bytes - h->last_tx) / secs;
+        h->head = (h->head + 1) % TRAFFIC_HISTORY;
+        if (h->len < TRAFFIC_HISTORY)
+            h->len++;
+        recorded = 1;
+    } else if (h->primed && now > h->last_time) {
+        // Counters were reset, e.g. the station reconnected
+        h->len = 0;
+        h->head = 0;
+    } else if (h->primed) {
+        return 0;
+    }
+
+    h->primed = 1;
+    h->last_rx = rx_bytes;
+    h->last_tx = tx_bytes;
+    h->last_time = now;
+    return recorded;
+}
+
+int traffic_history_len(const TrafficHistory *h){
+    return h->len;
+}
+
+/**
+ * Rate i of the history, 0 being the oldest and len - 1 the latest.
+ */
+void traffic_history_get(const TrafficHistory *h, int i, float *rx, float *tx){
+
+    int slot = (h->head + TRAFFIC_HISTORY - h->len + i) % TRAFFIC_HISTORY;
+
+    *rx = h->rx[slot];
+    *tx = h->tx[slot];
+}
+
+float traffic_history_peak(const TrafficHistory *h){
+
+    float peak = 0;
+
+    for (int i = 0; i < h->len; i++) {
+        float rx, tx;
+        traffic_history_get(h, i, &rx, &tx);
+        if (rx > peak)
+            peak = rx;
+        if (tx > peak)
+            peak = tx;
+    }
+    return peak;
+}
+
+TrafficMonitor *traffic_monitor_new(void){
+
+    TrafficMonitor *m = calloc(1, sizeof(*m));
+
+    if (m == NULL)
+        return NULL;
+
+    for (int i = 0; i < TRAFFIC_IFACE_COUNT; i++) {
+        m->ifaces[i].rx_fd = -1;
+        m->ifaces[i].tx_fd = -1;
+    }
+    return m;
+}
+
+static void close_iface(IfaceTraffic *it){
+
+    if (it->rx_fd >= 0)
+        close(it->rx_fd);
+    if (it->tx_fd >= 0)
+        close(it->tx_fd);
+    it->rx_fd = -1;
+    it->tx_fd = -1;
+}
+
+void traffic_monitor_free(TrafficMonitor *m){
+
+    if (m == NULL)
+        return;
+
+    for (int i = 0; i < TRAFFIC_IFACE_COUNT; i++)
+        close_iface(&m->ifaces[i]);
+    free(m->clients);
+    free(m);
+}
+
+static int open_counter(const char *ifname, const char *counter){
+
+    char path[128];
+
+    snprintf(path, sizeof(path), "/sys/class/net/%s/statistics/%s", ifname, counter);
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+static int read_counter(int fd, uint64_t *value){
+
+    char buf[32];
+    ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+
+    if (n <= 0)
+        return -1;
+    buf[n] = '\0';
+    *value = strtoull(buf, NULL, 10);
+    return 0;
+}
+
+/**
+ * Sample the counters of ifname into the given slot. The counter files are
+ * kept open between samples and reopened when the interface changes or
+ * goes away. Returns 0 on success.
+ */
+int traffic_monitor_sample_iface(TrafficMonitor *m, int slot, const char *ifname, int64_t now){
+
+    IfaceTraffic *it;
+    uint64_t rx, tx;
+
+    if (slot < 0 || slot >= TRAFFIC_IFACE_COUNT)
+        return -1;
+    it = &m->ifaces[slot];
+
+    if (ifname == NULL || strcmp(it->name, ifname) != 0) {
+        close_iface(it);
+        traffic_history_reset(&it->history);
+        snprintf(it->name, sizeof(it->name), "%s", ifname != NULL ? ifname : "");
+    }
+
+    if (it->name[0] == '\0')
+        return -1;
+
+    if (it->rx_fd < 0) {
+        it->rx_fd = open_counter(it->name, "rx_bytes");
+        it->tx_fd = open_counter(it->name, "tx_bytes");
+    }
+
+    if (it->rx_fd < 0 || it->tx_fd < 0 || read_counter(it->rx_fd, &rx) < 0 || read_counter(it->tx_fd, &tx) < 0) {
+        // The interface was removed, a new one may get the same name
+        close_iface(it);
+        traffic_history_reset(&it->history);
+        return -1;
+    }
+
+    traffic_history_push(&it->history, rx, tx, now);
+    return 0;
+}
+
+const char *traffic_monitor_iface_name(const TrafficMonitor *m, int slot){
+    return (slot >= 0 && slot < TRAFFIC_IFACE_COUNT) ? m->ifaces[slot].name : "";
+}
+
+const TrafficHistory *traffic_monitor_iface(const TrafficMonitor *m, int slot){
+    return (slot >= 0 && slot < TRAFFIC_IFACE_COUNT) ? &m->ifaces[slot].history : NULL;
+}
+
+/**
+ * Binary search for mac. Returns its index, or -(insertion point) - 1.
+ */
+static int find_client(const TrafficMonitor *m, const unsigned char *mac){
+
+    int lo = 0, hi = m->count - 1;
+
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = memcmp(m->clients[mid].mac, mac, 6);
+
+        if (cmp == 0)
+            return mid;
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return -lo - 1;
+}
+
+void traffic_monitor_begin(TrafficMonitor *m){
+    m->generation++;
+}
+
+int traffic_monitor_sample_client(TrafficMonitor *m, const unsigned char *mac,
+                                  uint64_t rx_bytes, uint64_t tx_bytes, int64_t now){
+
+    int i = find_client(m, mac);
+
+    if (i < 0) {
+        i = -i - 1;
+
+        if (m->count == m->cap) {
+            int cap = m->cap != 0 ? m->cap * 2 : MIN_CLIENTS;
+            ClientTraffic *clients = realloc(m->clients, cap * sizeof(*clients));
+            if (clients == NULL)
+                return -1;
+            m->clients = clients;
+            m->cap = cap;
+        }
+
+        memmove(&m->clients[i + 1], &m->clients[i], (m->count - i) * sizeof(*m->clients));
+        memcpy(m->clients[i].mac, mac, 6);
+        traffic_history_reset(&m->clients[i].history);
+        m->count++;
+    }
+
+    m->clients[i].seen = m->generation;
+    traffic_history_push(&m->clients[i].history, rx_bytes, tx_bytes, now);
+    return 0;
+}
+
+/**
+ * Drop the clients that were not sampled since traffic_monitor_begin().
+ */
+void traffic_monitor_end(TrafficMonitor *m){
+
+    int n = 0;
+
+    for (int i = 0; i < m->count; i++) {
+        if (m->clients[i].seen != m->generation)
+            continue;
+        if (n != i)
+            m->clients[n] = m->clients[i];
+        n++;
+    }
+    m->count = n;
+}
+
+const TrafficHistory *traffic_monitor_client(const TrafficMonitor *m, const unsigned char *mac){
+
+    int i = find_client(m, mac);
+
+    return i >= 0 ? &m->clients[i].history : NULL;
+}
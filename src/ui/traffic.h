@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_TRAFFIC_H
+#define WIHOTSPOT_TRAFFIC_H
+
+#include <stdint.h>
+
+/*
+ * Throughput history of the hotspot interfaces and of every client.
+ *
+ * Each sample is a pair of byte counters and a timestamp. The rate since
+ * the previous sample goes into a fixed size ring buffer, so memory does
+ * not grow with uptime. A counter that goes backwards restarts the history
+ * instead of producing a bogus rate.
+ *
+ * Interface counters are read from /sys/class/net/<iface>/statistics.
+ * Client counters come from the caller, usually an nl80211 station dump.
+ * Clients are kept sorted by MAC address and dropped once they are no
+ * longer sampled.
+ */
+
+#define TRAFFIC_HISTORY 60
+
+/* Sampling interval in ms, the TRAFFIC_SAMPLE_MS config key */
+#define TRAFFIC_SAMPLE_MS_DEFAULT 1000
+#define TRAFFIC_SAMPLE_MS_MIN 100
+#define TRAFFIC_SAMPLE_MS_MAX 60000
+
+#define TRAFFIC_IFACE_AP 0
+#define TRAFFIC_IFACE_UPLINK 1
+#define TRAFFIC_IFACE_COUNT 2
+
+typedef struct {
+    float rx[TRAFFIC_HISTORY];  // bytes/s
+    float tx[TRAFFIC_HISTORY];
+    uint16_t head;              // next slot to write
+    uint16_t len;
+    uint8_t primed;             // last_* hold a sample
+    uint64_t last_rx;
+    uint64_t last_tx;
+    int64_t last_time;          // us
+} TrafficHistory;
+
+unsigned int traffic_sample_interval(const char *value);
+
+void traffic_history_reset(TrafficHistory *h);
+int traffic_history_push(TrafficHistory *h, uint64_t rx_bytes, uint64_t tx_bytes, int64_t now);
+int traffic_history_len(const TrafficHistory *h);
+void traffic_history_get(const TrafficHistory *h, int i, float *rx, float *tx);
+float traffic_history_peak(const TrafficHistory *h);
+
+typedef struct TrafficMonitor TrafficMonitor;
+
+TrafficMonitor *traffic_monitor_new(void);
+void traffic_monitor_free(TrafficMonitor *m);
+
+int traffic_monitor_sample_iface(TrafficMonitor *m, int slot, const char *ifname, int64_t now);
+const char *traffic_monitor_iface_name(const TrafficMonitor *m, int slot);
+const TrafficHistory *traffic_monitor_iface(const TrafficMonitor *m, int slot);
+
+void traffic_monitor_begin(TrafficMonitor *m);
+int traffic_monitor_sample_client(TrafficMonitor *m, const unsigned char *mac,
+                                  uint64_t rx_bytes, uint64_t tx_bytes, int64_t now);
+void traffic_monitor_end(TrafficMonitor *m);
+const TrafficHistory *traffic_monitor_client(const TrafficMonitor *m, const unsigned char *mac);
+
+#endif //WIHOTSPOT_TRAFFIC_H
@@ -31,19 +31,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <gtk/gtk.h>
+#include <glib-unix.h>
+#include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 #include <X11/Xlib.h>
-#include <regex.h>
 
 #include "h_prop.h"
 #include "ui.h"
 #include "read_config.h"
 #include "util.h"
+#include "validator.h"
 #include "about_ui.h"
 #include "qr_ui.h"
+#include "dashboard_ui.h"
+#include "iface_list.h"
+#include "instance_watch.h"
+#include "hostapd_ctrl.h"
+#include "trace_summary.h"
+#include "../helper/helper_proto.h"
 
 #define BUFSIZE 512
 #define AP_ENABLED "AP-ENABLED"
+#define CREATE_LABEL "Create hotspot"
+#define APPLY_LABEL "Apply changes"
 
 #define INSTALL_PATH_PREFIX "/usr/share/wihotspot"
 #define ERROR_SSID_MSG "SSID must not empty"
@@ -54,22 +65,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define ERROR_MAC_MSG "Invalid Mac address"
 #define ERROR_GATEWAY_MSG "Invalid gateway IP address"
 
+#define MAC_ERROR_TAG "mac-error"
+#define MAX_MAC_ERRORS 64
+
 #define DEFAULT_GATEWAY_IP "192.168.12.1"
 
+#define SPARKLINE_WIDTH 120
+#define SPARKLINE_HEIGHT 24
+
 GtkBuilder *builder;
 GObject *window;
 GtkButton *button_create_hp;
 GtkButton *button_stop_hp;
 GtkButton *button_about;
 GtkButton *button_qr;
+GtkButton *button_dashboard;
 GtkButton *button_refresh;
 
-GtkGrid *grid_devices;
-GtkWidget *label_cd_hostname;
-GtkWidget *label_cd_ip;
-GtkWidget *label_cd_mac;
-GtkWidget *label_cd_number;
-PtrToNode device_list;
+GtkTreeView *tree_devices;
+GtkComboBox *combo_device_filter;
+GtkEntry *entry_device_filter;
+
+GtkGrid *grid_traffic;
+GtkWidget *label_iface_name[TRAFFIC_IFACE_COUNT];
+GtkWidget *label_iface_rate[TRAFFIC_IFACE_COUNT];
 
 GtkEntry *entry_ssd;
 GtkEntry *entry_pass;
@@ -82,6 +101,7 @@ GtkTextBuffer *buffer_mac_filter;
 
 GtkComboBox *combo_wifi;
 GtkComboBox *combo_internet;
+GtkComboBox *combo_rotate;
 
 GtkRadioButton *rb_freq_auto;
 GtkRadioButton *rb_freq_2;
@@ -129,17 +149,107 @@ char* running_info[3];
 guint pb_pulse_id;
 static ConfigValues configValues;
 
+enum {
+    DEVICE_COL_KEY,         // MAC packed by mac_key()
+    DEVICE_COL_HOSTNAME,
+    DEVICE_COL_IP,
+    DEVICE_COL_IP_SORT,     // host byte order
+    DEVICE_COL_MAC,
+    DEVICE_COL_RATE,
+    DEVICE_COL_RATE_SORT,   // bytes/s, both directions
+    DEVICE_COL_TOOLTIP,
+    DEVICE_COL_COUNT
+};
 
+// list store iter of a client, the store keeps its iters valid
+typedef struct {
+    guint64 key;
+    GtkTreeIter iter;
+} DeviceEntry;
 
-static void *stopHp(void *) {
-    if(running_info[0]!=NULL){
-        gtk_label_set_label(label_status,"Stopping ...");
-        start_pb_pulse();
-        lock_all_views(TRUE);
-        startShell(build_kill_create_ap_command(running_info[0]));
-        g_thread_new("init_running",init_running_info,NULL);
+static GtkListStore *device_store;
+static GtkTreeModel *device_filter;
+static GHashTable *device_entries;  // mac_key() -> DeviceEntry
+static gchar *device_filter_text;   // casefolded, NULL shows all
+static int device_filter_column;    // DEVICE_COL_*, -1 for all text columns
+
+static TrafficMonitor *traffic;
+static guint traffic_sample_id;
+
+// station events of the running instance, relayed by the helper
+static AsyncCmd *station_events;
+static guint station_events_gen;  // tells a cancelled follow from the current one
+static gchar *station_events_pid;
+static gboolean station_events_failed;
+
+// how long the start of the running instance took, from create_ap --trace
+static gchar *start_trace_pid;
+static long long start_trace_total;  // microseconds, 0 if it has no trace
+
+#define START_TRACE_FILE "trace.json"
+
+// create_ap rotates the passphrase in the saved config, see ROTATE_PASSPHRASE
+static GFileMonitor *config_monitor;
+
+
+
+static gboolean ap_enabled;
+
+static void on_start_line(const gchar *line, gpointer data) {
+
+    // create_ap keeps printing while it runs, the status label is ours after start
+    if (ap_enabled)
+        return;
+
+    gtk_label_set_label(label_status,line);
+
+    if (strstr(line, AP_ENABLED) != NULL) {
+        ap_enabled = TRUE;
+        init_running_info(NULL);
     }
-    return 0;
+}
+
+static void on_start_done(gint status, gpointer data) {
+
+    if (!ap_enabled)
+        printf("Command not found or exited with error status\n");
+
+    init_running_info(NULL);
+}
+
+static void on_reload_line(const gchar *line, gpointer data) {
+    gtk_label_set_label(label_status,line);
+}
+
+static void on_reload_done(gint status, gpointer data) {
+
+    // create_ap's last line says which option needs the restart
+    if (status == HELPER_RELOAD_NEEDS_RESTART)
+        set_error_text("Stop the hotspot to apply these changes");
+    else if (status != 0)
+        set_error_text("Could not apply the changes");
+    else
+        update_qr(configValues.ssid, "WPA", configValues.pass);
+
+    init_running_info(NULL);
+}
+
+static void on_config_written(gint status, gpointer data) {
+
+    if (status != 0) {
+        set_error_text("Could not write the configuration");
+        init_running_info(NULL);
+        return;
+    }
+
+    if (running_info[0] != NULL) {
+        gtk_label_set_label(label_status,"Applying changes ...");
+        reload_hotspot(running_info[0], configValues.freq, on_reload_line, on_reload_done, NULL);
+        return;
+    }
+
+    ap_enabled = FALSE;
+    start_hotspot(configValues.freq, on_start_line, on_start_done, NULL);
 }
 
 static void on_create_hp_clicked(GtkWidget *widget, gpointer data) {
@@ -156,17 +266,25 @@ static void on_create_hp_clicked(GtkWidget *widget, gpointer data) {
         set_error_text("");
     }
 
+    start_pb_pulse();
+    lock_all_views(TRUE);
 
-    startShell(build_wh_mkconfig_command(&configValues));
-
-    g_thread_new("shell_create_hp", run_create_hp_shell, (void*)build_wh_from_config());
+    write_hotspot_config(&configValues, on_config_written, NULL);
 
+}
 
+static void on_stop_done(gint status, gpointer data) {
+    init_running_info(NULL);
 }
 
 static void on_stop_hp_clicked(GtkWidget *widget, gpointer data) {
-    g_thread_new("shell2", stopHp, NULL);
 
+    if(running_info[0]!=NULL){
+        gtk_label_set_label(label_status,"Stopping ...");
+        start_pb_pulse();
+        lock_all_views(TRUE);
+        stop_hotspot(running_info[0], on_stop_done, NULL);
+    }
 }
 
 static void on_about_open_click(GtkWidget *widget, gpointer data){
@@ -175,8 +293,11 @@ static void on_about_open_click(GtkWidget *widget, gpointer data){
 
 static void on_qr_open_click(GtkWidget *widget, gpointer data){
 
-    char* image_path = generate_qr_image(configValues.ssid,"WPA",configValues.pass);
-    open_qr(widget,data,image_path);
+    open_qr(widget,data,configValues.ssid,"WPA",configValues.pass);
+}
+
+static void on_dashboard_open_click(GtkWidget *widget, gpointer data){
+    open_dashboard(widget,data);
 }
 
 
@@ -332,12 +453,43 @@ static void* entry_channel_warn(GtkWidget *widget, gpointer data){
     return NULL;
 }
 
+/**
+ * Underline the lines of the accept list that are not valid and show where
+ * the first error is.
+ */
 static void* tv_mac_filter_warn(){
 
+    ValidatorError errors[MAX_MAC_ERRORS];
+    size_t n_errors = 0;
+    GtkTextIter start, end;
+
+    gtk_text_buffer_get_bounds(buffer_mac_filter, &start, &end);
+    gtk_text_buffer_remove_tag_by_name(buffer_mac_filter, MAC_ERROR_TAG, &start, &end);
+
     if(gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(cb_mac_filter))==TRUE){
-        if (isValidAcceptedMacs(get_accepted_macs())==-1){
+        const gchar *macs = get_accepted_macs();
+
+        if (validator_mac_list(macs, strlen(macs), NULL, errors, MAX_MAC_ERRORS, &n_errors) <= 0){
+            char msg[BUFSIZE];
+
+            for (size_t i = 0; i < n_errors && i < MAX_MAC_ERRORS; i++) {
+                gtk_text_buffer_get_iter_at_line(buffer_mac_filter, &start, (gint) errors[i].line - 1);
+                end = start;
+                gtk_text_iter_forward_to_line_end(&end);
+                gtk_text_buffer_apply_tag_by_name(buffer_mac_filter, MAC_ERROR_TAG, &start, &end);
+            }
+
+            if (n_errors == 0)
+                snprintf(msg, sizeof(msg), "%s", ERROR_MAC_MSG);
+            else if (n_errors == 1)
+                snprintf(msg, sizeof(msg), "%s at line %u, column %u", ERROR_MAC_MSG,
+                         errors[0].line, errors[0].column);
+            else
+                snprintf(msg, sizeof(msg), "%s at line %u, column %u (%zu errors)", ERROR_MAC_MSG,
+                         errors[0].line, errors[0].column, n_errors);
+
             gtk_style_context_add_class(context_tv_mac_filter, "tv-mac-error");
-            set_error_text(ERROR_MAC_MSG);
+            set_error_text(msg);
             return FALSE;
         }
         else{
@@ -412,9 +564,13 @@ int initUi(int argc, char *argv[]){
     button_stop_hp = (GtkButton *) gtk_builder_get_object(builder, "button_stop_hp");
     button_about = (GtkButton *) gtk_builder_get_object(builder, "button_about");
     button_qr = (GtkButton *) gtk_builder_get_object(builder, "button_qr");
+    button_dashboard = (GtkButton *) gtk_builder_get_object(builder, "button_dashboard");
     button_refresh = (GtkButton *)gtk_builder_get_object(builder, "button_refresh");
 
-    grid_devices = (GtkGrid *)gtk_builder_get_object(builder, "grid_devices");
+    tree_devices = (GtkTreeView *)gtk_builder_get_object(builder, "tree_devices");
+    combo_device_filter = (GtkComboBox *)gtk_builder_get_object(builder, "combo_device_filter");
+    entry_device_filter = (GtkEntry *)gtk_builder_get_object(builder, "entry_device_filter");
+    grid_traffic = (GtkGrid *)gtk_builder_get_object(builder, "grid_traffic");
 
     entry_ssd = (GtkEntry *) gtk_builder_get_object(builder, "entry_ssid");
     entry_pass = (GtkEntry *) gtk_builder_get_object(builder, "entry_pass");
@@ -426,9 +582,11 @@ int initUi(int argc, char *argv[]){
     tv_mac_filter = (GtkTextView *) gtk_builder_get_object(builder, "tv_mac_filter");
 
     buffer_mac_filter = gtk_text_view_get_buffer (GTK_TEXT_VIEW (tv_mac_filter));
+    gtk_text_buffer_create_tag(buffer_mac_filter, MAC_ERROR_TAG, "underline", PANGO_UNDERLINE_ERROR, NULL);
 
     combo_wifi = (GtkComboBox *) gtk_builder_get_object(builder, "combo_wifi");
     combo_internet = (GtkComboBox *) gtk_builder_get_object(builder, "combo_internet");
+    combo_rotate = (GtkComboBox *) gtk_builder_get_object(builder, "combo_rotate");
 
     cb_hidden = (GtkCheckButton *) gtk_builder_get_object(builder, "cb_hidden");
     cb_no_haveged = (GtkCheckButton *) gtk_builder_get_object(builder, "cb_no_haveged");
@@ -464,6 +622,7 @@ int initUi(int argc, char *argv[]){
     g_signal_connect (button_stop_hp, "clicked", G_CALLBACK(on_stop_hp_clicked), NULL);
     g_signal_connect (button_about, "clicked", G_CALLBACK(on_about_open_click), NULL);
     g_signal_connect (button_qr, "clicked", G_CALLBACK(on_qr_open_click), NULL);
+    g_signal_connect (button_dashboard, "clicked", G_CALLBACK(on_dashboard_open_click), NULL);
     g_signal_connect (button_refresh, "clicked", G_CALLBACK(on_refresh_clicked), NULL);
     g_signal_connect (cb_open, "toggled", G_CALLBACK(on_cb_open_toggle), NULL);
     g_signal_connect (cb_mac, "toggled", G_CALLBACK(on_cb_mac_toggle), NULL); //new
@@ -485,11 +644,17 @@ int initUi(int argc, char *argv[]){
     g_signal_connect (rb_freq_auto, "toggled", G_CALLBACK(update_freq_toggle), NULL);
 
 
+    init_traffic_view();
+    init_device_view();
+
     start_pb_pulse();
-    g_thread_new("init_running",init_running_info,NULL);
+    watch_instances();
+    init_running_info(NULL);
 
+    watch_interface_list();
     init_interface_list();
     init_ui_from_config();
+    watch_config_file();
 
 
     gtk_main();
@@ -518,6 +683,9 @@ void init_ui_from_config(){
             // This line will trigger on_cb_open_toggle callback and disable the entry_pass
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(cb_open),TRUE);
 
+        if(values->rotate_passphrase==NULL || !gtk_combo_box_set_active_id(combo_rotate,values->rotate_passphrase))
+            gtk_combo_box_set_active_id(combo_rotate,"never");
+
         if(values->iface_wifi!=NULL){
             int idw=find_str(values->iface_wifi,wifi_iface_list,wifi_iface_list_length);
 
@@ -616,13 +784,34 @@ void init_ui_from_config(){
     }
 }
 
+/**
+ * Re-select the entry with the given text after the combo box was refilled
+*/
+static void restore_combo_selection(GtkComboBox *combo, const char **list, int length, gchar *text){
+
+    if (text == NULL)
+        return;
+
+    int idx = find_str(text, list, length);
+    if (idx != -1)
+        gtk_combo_box_set_active(combo, idx);
+
+    g_free(text);
+}
+
 void init_interface_list(){
 
+    gchar *active_wifi = gtk_combo_box_text_get_active_text(GTK_COMBO_BOX_TEXT(combo_wifi));
+    gchar *active_internet = gtk_combo_box_text_get_active_text(GTK_COMBO_BOX_TEXT(combo_internet));
+
     iface_list_length=0;
     wifi_iface_list_length=0;
     iface_list=(const char**)get_interface_list(&iface_list_length);
     wifi_iface_list=(const char**)get_wifi_interface_list(&wifi_iface_list_length);
 
+    gtk_combo_box_text_remove_all(GTK_COMBO_BOX_TEXT(combo_internet));
+    gtk_combo_box_text_remove_all(GTK_COMBO_BOX_TEXT(combo_wifi));
+
     for (int i = 0; i < iface_list_length; i++){
 
         gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo_internet), iface_list[i]);
@@ -632,6 +821,32 @@ void init_interface_list(){
         gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo_wifi), wifi_iface_list[i]);
     }
 
+    restore_combo_selection(combo_internet, iface_list, iface_list_length, active_internet);
+    restore_combo_selection(combo_wifi, wifi_iface_list, wifi_iface_list_length, active_wifi);
+
+}
+
+/**
+ * Called when an interface is added, removed or renamed (ex: USB dongle plugged in)
+*/
+static gboolean on_iface_event(gint fd, GIOCondition condition, gpointer data){
+
+    if (iface_monitor_dispatch() > 0)
+        init_interface_list();
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void watch_interface_list(){
+
+    int fd = iface_monitor_fd();
+
+    if (fd < 0) {
+        g_print("Could not subscribe to interface changes\n");
+        return;
+    }
+
+    g_unix_fd_add(fd, G_IO_IN, on_iface_event, NULL);
 }
 
 
@@ -660,21 +875,19 @@ void lock_all_views(gboolean set_lock){
 
 void lock_running_views(gboolean set_lock){
     if(set_lock){
-        gtk_editable_set_editable( (GtkEditable*)entry_ssd,FALSE);
-        gtk_editable_set_editable( (GtkEditable*)entry_pass,FALSE);
-        gtk_widget_set_sensitive ((GtkWidget*)button_create_hp, FALSE);
+        // the running hotspot is reloaded in place, interfaces need a restart
+        gtk_button_set_label(button_create_hp, APPLY_LABEL);
 
         gtk_widget_set_sensitive ((GtkWidget*)button_stop_hp, TRUE);
         gtk_widget_set_sensitive ((GtkWidget*)button_qr, TRUE);
 
         gtk_widget_set_sensitive ((GtkWidget*)combo_internet, FALSE);
         gtk_widget_set_sensitive ((GtkWidget*)combo_wifi, FALSE);
-
-        gtk_widget_set_sensitive ((GtkWidget*)tv_mac_filter, FALSE);
     } else{
         gtk_editable_set_editable( (GtkEditable*)entry_ssd,TRUE);
         gtk_editable_set_editable( (GtkEditable*)entry_pass,TRUE);
         gtk_widget_set_sensitive ((GtkWidget*)button_create_hp, TRUE);
+        gtk_button_set_label(button_create_hp, CREATE_LABEL);
 
         gtk_widget_set_sensitive ((GtkWidget*)button_stop_hp, FALSE);
         gtk_widget_set_sensitive ((GtkWidget*)button_qr, FALSE);
@@ -689,11 +902,16 @@ void lock_running_views(gboolean set_lock){
 
 static guint start_pb_pulse(){
     gtk_widget_set_visible((GtkWidget*)progress_bar,TRUE);
-    return pb_pulse_id= g_timeout_add (100, update_progress_in_timeout, progress_bar);
+    if (pb_pulse_id == 0)
+        pb_pulse_id = g_timeout_add (100, update_progress_in_timeout, progress_bar);
+    return pb_pulse_id;
 }
 
 static void stop_pb_pulse(){
-    g_source_remove(pb_pulse_id);
+    if (pb_pulse_id != 0) {
+        g_source_remove(pb_pulse_id);
+        pb_pulse_id = 0;
+    }
     gtk_widget_set_visible((GtkWidget*)progress_bar,FALSE);
 }
 
@@ -710,82 +928,194 @@ void clear_running_info(){
         running_info[0]=NULL;
 }
 
-void* init_running_info(void *){
+static void set_running_status(){
 
-    clear_running_info();
-    lock_all_views(TRUE);
+    char a[BUFSIZE];
+
+    if (start_trace_total > 0 && g_strcmp0(start_trace_pid, running_info[0]) == 0)
+        snprintf(a,BUFSIZE,"Running as PID: %s, last start took %.1f s",running_info[0],start_trace_total / 1e6);
+    else {
+        snprintf(a,BUFSIZE,"Running as PID: %s",running_info[0]);
+        gtk_widget_set_tooltip_text(GTK_WIDGET(label_status), NULL);
+    }
+    gtk_label_set_label(label_status,a);
+}
+
+/**
+ * Read the trace create_ap writes once the access point is up, and show
+ * the start time with the time of each phase in the tooltip. Instances
+ * that were not started with --trace never get one, they are retried on
+ * every sample.
+ */
+static void load_start_trace(){
+
+    char confdir[PATH_MAX];
+    char iface[IF_NAMESIZE];
+    char breakdown[BUFSIZE];
+    gchar *path, *json;
+    gsize length;
+    TraceSummary summary;
+
+    if (running_info[0] == NULL || g_strcmp0(start_trace_pid, running_info[0]) == 0)
+        return;
+
+    if (get_instance_confdir(running_info[0], confdir, sizeof(confdir), iface, sizeof(iface)) != 0)
+        return;
+
+    path = g_build_filename(confdir, START_TRACE_FILE, NULL);
+    if (!g_file_get_contents(path, &json, &length, NULL)) {
+        g_free(path);
+        return;
+    }
+    g_free(path);
+
+    g_free(start_trace_pid);
+    start_trace_pid = g_strdup(running_info[0]);
+    start_trace_total = 0;
+
+    // create_ap replaces the file in one go, one that does not parse stays broken
+    if (trace_summary_parse(json, length, "start", &summary) > 0
+        && trace_summary_format(&summary, breakdown, sizeof(breakdown)) >= 0) {
+        start_trace_total = summary.total;
+        gtk_widget_set_tooltip_text(GTK_WIDGET(label_status), breakdown);
+    }
+    g_free(json);
 
-    gtk_label_set_label(label_status,"Getting running info...");
+    set_running_status();
+}
 
-    get_h_running_info(running_info);
+static void show_running_info(){
 
     if(running_info[0]!=NULL){
 
-        char a[BUFSIZE];
-        snprintf(a,BUFSIZE,"Running as PID: %s",running_info[0]);
-        gtk_label_set_label(label_status,a);
+        set_running_status();
 
         lock_all_views(FALSE);
         lock_running_views(TRUE);
 
+        start_traffic_sampling();
 
     } else{
 
         gtk_label_set_label(label_status,"Not running");
+        gtk_widget_set_tooltip_text(GTK_WIDGET(label_status), NULL);
         lock_all_views(FALSE);
         lock_running_views(FALSE);
+
+        stop_traffic_sampling();
     }
 
     stop_pb_pulse();
+}
+
+static void on_running_info(char* a[3], gpointer data){
+
+    clear_running_info();
+    running_info[0] = g_strdup(a[0]);
+
+    for (int i = 0; i < 3; i++)
+        free(a[i]);
+
+    show_running_info();
+}
+
+/**
+ * Show the current instance. With the instance watcher this is only a
+ * lookup, otherwise create_ap --list-running is asked.
+ */
+void* init_running_info(void *data){
+
+    if (instance_watch_fd() >= 0) {
+        const InstanceInfo *inst;
+
+        clear_running_info();
+        instance_watch_dispatch();
+        if ((inst = instance_watch_current()) != NULL)
+            running_info[0] = g_strdup_printf("%d", (int) inst->pid);
+
+        show_running_info();
+    } else {
+        lock_all_views(TRUE);
+        gtk_label_set_label(label_status,"Getting running info...");
+        get_h_running_info(on_running_info, NULL);
+    }
+
     return 0;
 }
 
+static gboolean on_instance_event(gint fd, GIOCondition condition, gpointer data){
 
-static void *run_create_hp_shell(void *cmd) {
+    if (instance_watch_dispatch() > 0) {
+        init_running_info(NULL);
+        update_dashboard();
+    }
 
-    char buf[BUFSIZE];
-    char buf2[BUFSIZE];
-    FILE *fp;
+    return G_SOURCE_CONTINUE;
+}
 
-    if(configValues.freq){
-        cmd = strcat( cmd, " --freq-band ");
-        cmd = strcat(cmd, configValues.freq);
+static gboolean on_instance_poll(gpointer data){
 
-        if ((fp = popen(cmd, "r")) == NULL) {
-            printf("Error opening pipe!\n");
-            return NULL;
-        }
+    if (instance_watch_needs_poll() && instance_watch_dispatch() > 0) {
+        init_running_info(NULL);
+        update_dashboard();
     }
-    else{
-        if ((fp = popen(cmd, "r")) == NULL) {
-            printf("Error opening pipe!\n");
-            return NULL;
-        }
+
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * Show the passphrase create_ap rotated in the saved config. The rest of
+ * the form keeps what the user may be editing.
+ */
+static void on_config_file_changed(GFileMonitor *monitor, GFile *file, GFile *other, GFileMonitorEvent event,
+                                   gpointer data)
+{
+    ConfigValues saved;
+
+    if (event != G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT && event != G_FILE_MONITOR_EVENT_CREATED)
+        return;
+
+    if (config_values_load(get_config_file(CONFIG_FILE_NAME), &saved) != READ_CONFIG_FILE_SUCCESS)
+        return;
+
+    // Our own writes have the passphrase of the form
+    if (configValues.pass != NULL && saved.pass[0] != '\0' && strcmp(saved.pass, configValues.pass) != 0) {
+        gtk_entry_set_text(entry_pass, saved.pass);
+        configValues.pass = (char *) gtk_entry_get_text(entry_pass);
+        update_qr(configValues.ssid, "WPA", configValues.pass);
     }
 
+    config_values_free(&saved);
+}
 
+static void watch_config_file(){
 
-    start_pb_pulse();
+    GFile *file = g_file_new_for_path(get_config_file(CONFIG_FILE_NAME));
 
-    while (fgets(buf, BUFSIZE, fp) != NULL) {
-        buf[strcspn(buf, "\n")] = 0;
-        gtk_label_set_label(label_status,buf);
+    config_monitor = g_file_monitor_file(file, G_FILE_MONITOR_NONE, NULL, NULL);
+    g_object_unref(file);
 
-        if (strstr(buf, AP_ENABLED) != NULL) {
-            init_running_info(NULL);
-            pclose(fp);
-            return 0;
-        }
+    if (config_monitor == NULL) {
+        g_print("Could not watch %s\n", get_config_file(CONFIG_FILE_NAME));
+        return;
     }
 
-    if (pclose(fp)) {
-        printf("Command not found or exited with error status\n");
-        init_running_info(NULL);
-        return NULL;
+    g_signal_connect(config_monitor, "changed", G_CALLBACK(on_config_file_changed), NULL);
+}
+
+static void watch_instances(){
+
+    int fd = instance_watch_open();
+
+    if (fd < 0) {
+        g_print("Could not watch create_ap instances\n");
+        return;
     }
 
-    init_running_info(NULL);
-    return 0;
+    g_unix_fd_add(fd, G_IO_IN, on_instance_event, NULL);
+
+    // Kernels without pidfd_open() do not report exits of the instance
+    g_timeout_add_seconds(2, on_instance_poll, NULL);
 }
 
 
@@ -896,6 +1226,8 @@ static int init_config_val_input(ConfigValues* cv){
             cv->pass = (char *) gtk_entry_get_text(entry_pass);
         }
 
+        cv->rotate_passphrase = (char *) gtk_combo_box_get_active_id(combo_rotate);
+
         if(gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(rb_freq_2)))
             cv->freq = "2.4";
 
@@ -983,6 +1315,7 @@ gchar* get_accepted_macs(){
     /* Obtain iters for the start and end of points of the buffer */
     gtk_text_buffer_get_start_iter (buffer_mac_filter, &start);
     gtk_text_buffer_get_end_iter (buffer_mac_filter, &end);
+    g_free(accepted_macs);
     accepted_macs=gtk_text_buffer_get_text (buffer_mac_filter,&start,&end,TRUE);
 
     return accepted_macs;
@@ -994,51 +1327,572 @@ gchar* get_accepted_macs(){
 */
 static void clear_connecetd_devices_list(){
 
-    // Remove all the children widgets
-    GList *children, *iter;
+    gtk_list_store_clear(device_store);
+    g_hash_table_remove_all(device_entries);
+}
 
-    children = gtk_container_get_children(GTK_CONTAINER(grid_devices));
-    for (iter = children; iter != NULL; iter = g_list_next(iter))
-    {
-        gtk_widget_destroy(GTK_WIDGET(iter->data));
+/**
+ * Link details of a connected device, shown when hovering its row.
+ */
+static gchar* client_tooltip(const ClientRow *row)
+{
+    gchar *rx = g_format_size(row->rx_bytes);
+    gchar *tx = g_format_size(row->tx_bytes);
+    gchar *signal = row->has_signal ? g_strdup_printf("%d dBm", row->signal) : g_strdup("unknown");
+    gchar *text = g_strdup_printf("Signal: %s\n"
+                                  "TX bitrate: %u.%u Mbit/s\n"
+                                  "Received: %s (%u packets)\n"
+                                  "Sent: %s (%u packets, %u retries, %u failed)\n"
+                                  "Inactive: %u ms\n"
+                                  "Connected: %u s",
+                                  signal, row->tx_bitrate / 10, row->tx_bitrate % 10,
+                                  rx, row->rx_packets,
+                                  tx, row->tx_packets, row->tx_retries, row->tx_failed,
+                                  row->inactive_time, row->connected_time);
+    g_free(rx);
+    g_free(tx);
+    g_free(signal);
+    return text;
+}
+
+/**
+ * Latest rate of a history as "down / up". For the access point and its
+ * clients the download is what the AP transmits, for the uplink it is
+ * what the interface receives.
+ */
+static gchar* format_rate(const TrafficHistory *h, gboolean down_is_tx, float *total)
+{
+    float rx = 0, tx = 0;
+    gchar *down, *up, *text;
+
+    if (h != NULL && traffic_history_len(h) > 0)
+        traffic_history_get(h, traffic_history_len(h) - 1, &rx, &tx);
+
+    down = g_format_size((guint64) (down_is_tx ? tx : rx));
+    up = g_format_size((guint64) (down_is_tx ? rx : tx));
+    text = g_strdup_printf("\u2193 %s/s  \u2191 %s/s", down, up);
+
+    if (total != NULL)
+        *total = rx + tx;
+
+    g_free(down);
+    g_free(up);
+    return text;
+}
+
+static void set_rate_label(GtkWidget *label, const TrafficHistory *h, gboolean down_is_tx)
+{
+    gchar *text = format_rate(h, down_is_tx, NULL);
+
+    gtk_label_set_text(GTK_LABEL(label), text);
+    g_free(text);
+}
+
+static void draw_series(cairo_t *cr, const TrafficHistory *h, gboolean rx, int width, int height, float peak)
+{
+    int len = traffic_history_len(h);
+    double step = (double) width / (TRAFFIC_HISTORY - 1);
+
+    // Newest sample on the right edge
+    for (int i = 0; i < len; i++) {
+        float r, t;
+        double x = width - (len - 1 - i) * step;
+        double y;
+
+        traffic_history_get(h, i, &r, &t);
+        y = height - 1 - (rx ? r : t) / peak * (height - 2);
+
+        if (i == 0)
+            cairo_move_to(cr, x, y);
+        else
+            cairo_line_to(cr, x, y);
+    }
+    cairo_stroke(cr);
+}
+
+/**
+ * Draw the download and upload history of h, scaled to its own peak.
+ */
+static void draw_sparkline(cairo_t *cr, int width, int height, const TrafficHistory *h, gboolean down_is_tx)
+{
+    float peak;
+
+    if (h == NULL || traffic_history_len(h) < 2)
+        return;
+
+    peak = traffic_history_peak(h);
+    if (peak <= 0)
+        peak = 1;
+
+    cairo_set_line_width(cr, 1.5);
+
+    cairo_set_source_rgb(cr, 0.2, 0.5, 0.9);
+    draw_series(cr, h, !down_is_tx, width, height, peak);
+
+    cairo_set_source_rgb(cr, 0.3, 0.7, 0.3);
+    draw_series(cr, h, down_is_tx, width, height, peak);
+}
+
+static const TrafficHistory* client_history(const unsigned char *mac)
+{
+    return traffic != NULL ? traffic_monitor_client(traffic, mac) : NULL;
+}
+
+static gboolean on_iface_sparkline_draw(GtkWidget *widget, cairo_t *cr, gpointer data)
+{
+    int slot = GPOINTER_TO_INT(data);
+
+    if (traffic != NULL)
+        draw_sparkline(cr, gtk_widget_get_allocated_width(widget), gtk_widget_get_allocated_height(widget),
+                       traffic_monitor_iface(traffic, slot), slot != TRAFFIC_IFACE_UPLINK);
+    return FALSE;
+}
+
+static GtkWidget* new_sparkline(GCallback draw, gpointer data)
+{
+    GtkWidget *area = gtk_drawing_area_new();
+
+    gtk_widget_set_size_request(area, SPARKLINE_WIDTH, SPARKLINE_HEIGHT);
+    g_signal_connect(area, "draw", draw, data);
+    return area;
+}
+
+/**
+ * Build the AP and uplink rows below the device list.
+ */
+static void init_traffic_view()
+{
+    static const char *titles[TRAFFIC_IFACE_COUNT] = {"Access point", "Uplink"};
+
+    for (int i = 0; i < TRAFFIC_IFACE_COUNT; i++) {
+        GtkWidget *title = gtk_label_new(titles[i]);
+
+        label_iface_name[i] = gtk_label_new("");
+        label_iface_rate[i] = gtk_label_new("");
+        gtk_widget_set_halign(title, GTK_ALIGN_START);
+
+        gtk_grid_attach(grid_traffic, title, 0, i, 1, 1);
+        gtk_grid_attach(grid_traffic, label_iface_name[i], 1, i, 1, 1);
+        gtk_grid_attach(grid_traffic, label_iface_rate[i], 2, i, 1, 1);
+        gtk_grid_attach(grid_traffic, new_sparkline(G_CALLBACK(on_iface_sparkline_draw), GINT_TO_POINTER(i)), 3, i, 1, 1);
+    }
+
+    gtk_widget_show_all(GTK_WIDGET(grid_traffic));
+    gtk_widget_set_no_show_all(GTK_WIDGET(grid_traffic), TRUE);
+    gtk_widget_hide(GTK_WIDGET(grid_traffic));
+}
+
+static void update_iface_traffic()
+{
+    for (int i = 0; i < TRAFFIC_IFACE_COUNT; i++) {
+        gtk_label_set_text(GTK_LABEL(label_iface_name[i]), traffic_monitor_iface_name(traffic, i));
+        set_rate_label(label_iface_rate[i], traffic_monitor_iface(traffic, i), i != TRAFFIC_IFACE_UPLINK);
+    }
+    gtk_widget_show(GTK_WIDGET(grid_traffic));
+    gtk_widget_queue_draw(GTK_WIDGET(grid_traffic));
+}
+
+static guint64 mac_key(const unsigned char *mac)
+{
+    guint64 key = 0;
+
+    for (int i = 0; i < 6; i++)
+        key = key << 8 | mac[i];
+    return key;
+}
+
+static void key_mac(guint64 key, unsigned char *mac)
+{
+    for (int i = 5; i >= 0; i--, key >>= 8)
+        mac[i] = key & 0xff;
+}
+
+static void add_device(const ClientTable *clients, const ClientRow *row)
+{
+    DeviceEntry *e = g_new(DeviceEntry, 1);
+    char ip[INET_ADDRSTRLEN];
+    char mac[18];
+    float total;
+    gchar *rate = format_rate(client_history(row->mac), TRUE, &total);
+    gchar *tooltip = client_tooltip(row);
+
+    client_format_ipv4(row->ipv4, ip);
+    client_format_mac(row->mac, mac);
+
+    e->key = mac_key(row->mac);
+    gtk_list_store_insert_with_values(device_store, &e->iter, -1,
+                                      DEVICE_COL_KEY, e->key,
+                                      DEVICE_COL_HOSTNAME, client_table_hostname(clients, row),
+                                      DEVICE_COL_IP, ip,
+                                      DEVICE_COL_IP_SORT, (guint) ntohl(row->ipv4),
+                                      DEVICE_COL_MAC, mac,
+                                      DEVICE_COL_RATE, rate,
+                                      DEVICE_COL_RATE_SORT, (gdouble) total,
+                                      DEVICE_COL_TOOLTIP, tooltip,
+                                      -1);
+    g_hash_table_insert(device_entries, &e->key, e);
+
+    g_free(rate);
+    g_free(tooltip);
+}
+
+/**
+ * Write what changed to the row of a client. Hostname and IP only change
+ * with its lease, the rates and counters with every read.
+ */
+static void update_device(DeviceEntry *e, const ClientTable *clients, const ClientRow *row)
+{
+    float total;
+    gchar *rate = format_rate(client_history(row->mac), TRUE, &total);
+    gchar *tooltip = client_tooltip(row);
+
+    // A row added from a station event gets its lease later on
+    if (row->state != CLIENT_UNCHANGED) {
+        char ip[INET_ADDRSTRLEN];
+
+        client_format_ipv4(row->ipv4, ip);
+        gtk_list_store_set(device_store, &e->iter,
+                           DEVICE_COL_HOSTNAME, client_table_hostname(clients, row),
+                           DEVICE_COL_IP, ip,
+                           DEVICE_COL_IP_SORT, (guint) ntohl(row->ipv4),
+                           -1);
+    }
+
+    gtk_list_store_set(device_store, &e->iter,
+                       DEVICE_COL_RATE, rate,
+                       DEVICE_COL_RATE_SORT, (gdouble) total,
+                       DEVICE_COL_TOOLTIP, tooltip,
+                       -1);
+    g_free(rate);
+    g_free(tooltip);
+}
+
+static void remove_device(const unsigned char *mac)
+{
+    guint64 key = mac_key(mac);
+    DeviceEntry *e = g_hash_table_lookup(device_entries, &key);
+
+    if (e != NULL) {
+        gtk_list_store_remove(device_store, &e->iter);
+        g_hash_table_remove(device_entries, &key);
     }
-    g_list_free(children);
 }
 
 /**
  * Set connected device list
  *
+ * The list store is updated from the client table diff: rows of clients
+ * that left are removed, new clients are appended and the others only get
+ * the columns that changed. The same station dump is sampled for the
+ * rates; station events only touch their own row in between.
 */
 static void set_connected_devices_label()
 {
-    Position tmp;
-    device_list = get_connected_devices(running_info[0]); // running_info[0] PID
+    const ClientTable *clients = get_connected_devices(running_info[0], traffic); // running_info[0] PID
+
+    if (clients == NULL) {
+        clear_connecetd_devices_list();
+        return;
+    }
+
+    if (traffic != NULL)
+        update_iface_traffic();
+
+    for (int i = 0; i < client_table_removed_count(clients); i++)
+        remove_device(client_table_removed(clients, i));
+
+    for (int i = 0; i < client_table_count(clients); i++) {
+        const ClientRow *row = client_table_row(clients, i);
+        guint64 key = mac_key(row->mac);
+        DeviceEntry *e = g_hash_table_lookup(device_entries, &key);
+
+        if (e == NULL)
+            add_device(clients, row);
+        else
+            update_device(e, clients, row);
+    }
+
+    // Should the list and the table ever disagree, start over
+    if (g_hash_table_size(device_entries) != (guint) client_table_count(clients)) {
+        clear_connecetd_devices_list();
+        for (int i = 0; i < client_table_count(clients); i++)
+            add_device(clients, client_table_row(clients, i));
+    }
+}
+
+/** Position in the sorted and filtered list. */
+static void render_device_number(GtkTreeViewColumn *column, GtkCellRenderer *cell, GtkTreeModel *model,
+                                 GtkTreeIter *iter, gpointer data)
+{
+    GtkTreePath *path = gtk_tree_model_get_path(model, iter);
+    char number[12];
+
+    snprintf(number, sizeof(number), "%d", gtk_tree_path_get_indices(path)[0] + 1);
+    g_object_set(cell, "text", number, NULL);
+    gtk_tree_path_free(path);
+}
+
+/** Only called for visible rows, so only those are drawn. */
+static void render_device_sparkline(GtkTreeViewColumn *column, GtkCellRenderer *cell, GtkTreeModel *model,
+                                    GtkTreeIter *iter, gpointer data)
+{
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, SPARKLINE_WIDTH, SPARKLINE_HEIGHT);
+    cairo_t *cr = cairo_create(surface);
+    unsigned char mac[6];
+    guint64 key;
+
+    gtk_tree_model_get(model, iter, DEVICE_COL_KEY, &key, -1);
+    key_mac(key, mac);
+
+    draw_sparkline(cr, SPARKLINE_WIDTH, SPARKLINE_HEIGHT, client_history(mac), TRUE);
+    cairo_destroy(cr);
+
+    g_object_set(cell, "surface", surface, NULL);
+    cairo_surface_destroy(surface);
+}
+
+static gboolean device_visible(GtkTreeModel *model, GtkTreeIter *iter, gpointer data)
+{
+    static const int text_columns[] = {DEVICE_COL_HOSTNAME, DEVICE_COL_IP, DEVICE_COL_MAC};
+    gboolean visible = FALSE;
+
+    if (device_filter_text == NULL)
+        return TRUE;
+
+    for (size_t i = 0; i < G_N_ELEMENTS(text_columns) && !visible; i++) {
+        gchar *value, *folded;
+
+        if (device_filter_column >= 0 && text_columns[i] != device_filter_column)
+            continue;
+
+        gtk_tree_model_get(model, iter, text_columns[i], &value, -1);
+        if (value == NULL)
+            continue;
+
+        folded = g_utf8_casefold(value, -1);
+        visible = strstr(folded, device_filter_text) != NULL;
+        g_free(folded);
+        g_free(value);
+    }
+
+    return visible;
+}
+
+static void on_device_filter_changed(GtkWidget *widget, gpointer data)
+{
+    const gchar *text = gtk_entry_get_text(entry_device_filter);
+    const gchar *id = gtk_combo_box_get_active_id(combo_device_filter);
+
+    g_free(device_filter_text);
+    device_filter_text = *text != '\0' ? g_utf8_casefold(text, -1) : NULL;
+
+    if (g_strcmp0(id, "hostname") == 0)
+        device_filter_column = DEVICE_COL_HOSTNAME;
+    else if (g_strcmp0(id, "ip") == 0)
+        device_filter_column = DEVICE_COL_IP;
+    else if (g_strcmp0(id, "mac") == 0)
+        device_filter_column = DEVICE_COL_MAC;
+    else
+        device_filter_column = -1;
+
+    gtk_tree_model_filter_refilter(GTK_TREE_MODEL_FILTER(device_filter));
+}
+
+static GtkTreeViewColumn* add_device_column(const char *title, int width, GtkCellRenderer *cell,
+                                            int column, GtkTreeCellDataFunc render, int sort_column)
+{
+    GtkTreeViewColumn *col = gtk_tree_view_column_new();
+
+    gtk_tree_view_column_set_title(col, title);
+    gtk_tree_view_column_pack_start(col, cell, FALSE);
+    if (render != NULL)
+        gtk_tree_view_column_set_cell_data_func(col, cell, render, NULL, NULL);
+    else
+        gtk_tree_view_column_add_attribute(col, cell, "text", column);
+
+    // fixed-height-mode, set in the UI file, needs fixed columns
+    gtk_tree_view_column_set_sizing(col, GTK_TREE_VIEW_COLUMN_FIXED);
+    gtk_tree_view_column_set_fixed_width(col, width);
+    gtk_tree_view_column_set_resizable(col, TRUE);
+    if (sort_column >= 0)
+        gtk_tree_view_column_set_sort_column_id(col, sort_column);
+
+    gtk_tree_view_append_column(tree_devices, col);
+    return col;
+}
+
+/**
+ * The device list is a list store, filtered and sorted by the view.
+ * Clicking a header sorts by that column.
+ */
+static void init_device_view()
+{
+    GtkTreeModel *sort;
+    GtkTreeViewColumn *traffic_column;
+    GtkCellRenderer *sparkline = gtk_cell_renderer_pixbuf_new();
+
+    device_store = gtk_list_store_new(DEVICE_COL_COUNT, G_TYPE_UINT64, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_UINT,
+                                      G_TYPE_STRING, G_TYPE_STRING, G_TYPE_DOUBLE, G_TYPE_STRING);
+    device_entries = g_hash_table_new_full(g_int64_hash, g_int64_equal, NULL, g_free);
+    device_filter_column = -1;
+
+    device_filter = gtk_tree_model_filter_new(GTK_TREE_MODEL(device_store), NULL);
+    gtk_tree_model_filter_set_visible_func(GTK_TREE_MODEL_FILTER(device_filter), device_visible, NULL, NULL);
+    sort = gtk_tree_model_sort_new_with_model(device_filter);
+    gtk_tree_view_set_model(tree_devices, sort);
+    g_object_unref(sort);
+
+    add_device_column("Number", 60, gtk_cell_renderer_text_new(), -1, render_device_number, -1);
+    add_device_column("Hostname", 140, gtk_cell_renderer_text_new(), DEVICE_COL_HOSTNAME, NULL, DEVICE_COL_HOSTNAME);
+    add_device_column("IP", 110, gtk_cell_renderer_text_new(), DEVICE_COL_IP, NULL, DEVICE_COL_IP_SORT);
+    add_device_column("MAC", 140, gtk_cell_renderer_text_new(), DEVICE_COL_MAC, NULL, DEVICE_COL_MAC);
+    traffic_column = add_device_column("Traffic", 180 + SPARKLINE_WIDTH, gtk_cell_renderer_text_new(),
+                                       DEVICE_COL_RATE, NULL, DEVICE_COL_RATE_SORT);
+
+    gtk_cell_renderer_set_fixed_size(sparkline, SPARKLINE_WIDTH, SPARKLINE_HEIGHT);
+    gtk_tree_view_column_pack_start(traffic_column, sparkline, TRUE);
+    gtk_tree_view_column_set_cell_data_func(traffic_column, sparkline, render_device_sparkline, NULL, NULL);
+
+    gtk_tree_view_set_tooltip_column(tree_devices, DEVICE_COL_TOOLTIP);
+
+    g_signal_connect(entry_device_filter, "search-changed", G_CALLBACK(on_device_filter_changed), NULL);
+    g_signal_connect(combo_device_filter, "changed", G_CALLBACK(on_device_filter_changed), NULL);
+}
+
+static gboolean on_traffic_sample(gpointer data)
+{
+    if (running_info[0] == NULL) {
+        traffic_sample_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    // hostapd may not have been up yet when the instance appeared
+    start_station_events();
+    load_start_trace();
+    set_connected_devices_label();
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * Sample the running instance while it is up, as often as the
+ * TRAFFIC_SAMPLE_MS config key says.
+ */
+static void start_traffic_sampling()
+{
+    if (traffic == NULL)
+        traffic = traffic_monitor_new();
+
+    start_station_events();
+    load_start_trace();
+
+    if (traffic_sample_id == 0 && traffic != NULL) {
+        set_connected_devices_label();
+        traffic_sample_id = g_timeout_add(traffic_sample_interval(configValues.traffic_sample_ms),
+                                          on_traffic_sample, NULL);
+    }
+}
+
+static void stop_traffic_sampling()
+{
+    stop_station_events();
+
+    if (traffic_sample_id != 0) {
+        g_source_remove(traffic_sample_id);
+        traffic_sample_id = 0;
+    }
+
+    traffic_monitor_free(traffic);
+    traffic = NULL;
 
     clear_connecetd_devices_list();
+    gtk_widget_hide(GTK_WIDGET(grid_traffic));
+}
 
-    while (device_list->Next != NULL)
-    {
-        tmp = device_list; // Save the last one
-        device_list = device_list->Next;
-        char number[2];
-        sprintf(number, "%d", device_list->Number);
-        label_cd_number = gtk_label_new(number);
-        label_cd_hostname = gtk_label_new(device_list->HOSTNAME);
-        label_cd_ip = gtk_label_new(device_list->IP);
-        label_cd_mac = gtk_label_new(device_list->MAC);
-
-        gtk_grid_attach(grid_devices, label_cd_number, 0, device_list->Number, 1, 1);
-        gtk_grid_attach(grid_devices, label_cd_hostname, 1, device_list->Number, 1, 1);
-        gtk_grid_attach(grid_devices, label_cd_ip, 2, device_list->Number, 1, 1);
-        gtk_grid_attach(grid_devices, label_cd_mac, 3, device_list->Number, 1, 1);
-        gtk_widget_show_all((GtkWidget *)grid_devices);
-        free(tmp); // Free the last pointer
+/**
+ * Update the row of a station as soon as hostapd reports that it joined,
+ * left or finished its handshake, instead of on the next sample. Only
+ * that station is read; the samples keep the counters of the others.
+ */
+static void on_station_event(const gchar *line, gpointer data)
+{
+    HostapdEvent event;
+    const ClientTable *clients;
+    const ClientRow *row;
+    DeviceEntry *e;
+    guint64 key;
+
+    if (hostapd_event_parse(line, strlen(line), &event) < 0 || running_info[0] == NULL)
+        return;
+
+    if (event.type == HOSTAPD_EVENT_STA_DISCONNECTED) {
+        forget_connected_device(event.mac);
+        remove_device(event.mac);
+        return;
     }
+
+    if ((clients = get_connected_device(running_info[0], event.mac)) == NULL)
+        return;
+
+    if ((row = client_table_row(clients, client_table_find(clients, event.mac))) == NULL) {
+        remove_device(event.mac);
+        return;
+    }
+
+    key = mac_key(event.mac);
+    if ((e = g_hash_table_lookup(device_entries, &key)) == NULL)
+        add_device(clients, row);
+    else
+        update_device(e, clients, row);
+}
+
+static void on_station_events_done(gint status, gpointer data)
+{
+    // A cancelled follow may end after the next one started
+    if (GPOINTER_TO_UINT(data) != station_events_gen)
+        return;
+
+    station_events = NULL;
+    // Without the helper there are no events and the device list is only
+    // updated on samples. Anything else, e.g. hostapd not being up yet, is
+    // tried again on the next sample.
+    station_events_failed = status == ASYNC_CMD_FAILED;
 }
 
 /**
- * When conncetd devices refresh button clicked
-*/
+ * Follow the hostapd of the running instance through the helper, which
+ * keeps the control socket to root.
+ */
+static void start_station_events()
+{
+    if (running_info[0] == NULL)
+        return;
+
+    // A new instance has its own hostapd
+    if (station_events_pid != NULL && strcmp(station_events_pid, running_info[0]) != 0)
+        stop_station_events();
+
+    if (station_events != NULL || station_events_failed)
+        return;
+
+    g_free(station_events_pid);
+    station_events_pid = g_strdup(running_info[0]);
+
+    station_events = follow_station_events(running_info[0], on_station_event, on_station_events_done,
+                                           GUINT_TO_POINTER(station_events_gen));
+}
+
+static void stop_station_events()
+{
+    if (station_events != NULL) {
+        station_events_gen++;
+        async_cmd_cancel(station_events);
+        station_events = NULL;
+    }
+
+    station_events_failed = FALSE;
+    g_clear_pointer(&station_events_pid, g_free);
+}
+
 static void on_refresh_clicked(GtkWidget *widget, gpointer data)
 {
     if (running_info[0] != NULL)
@@ -1057,8 +1911,10 @@ static void on_cb_open_toggle(GtkWidget *widget, gpointer data)
 {
     if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widget))) {
         gtk_widget_set_sensitive((GtkWidget*)entry_pass, FALSE);
+        gtk_widget_set_sensitive((GtkWidget*)combo_rotate, FALSE);
     } else {
         gtk_widget_set_sensitive((GtkWidget*)entry_pass, TRUE);
+        gtk_widget_set_sensitive((GtkWidget*)combo_rotate, TRUE);
     }
 }
 
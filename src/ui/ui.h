@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtk/gtk.h>
 
 #include "read_config.h"
+#include "client_table.h"
 
 typedef struct {
     GtkEntry *ssid;
@@ -44,10 +45,17 @@ int initUi(int argc, char *argv[]);
 
 void init_ui_from_config();
 
-static void* run_create_hp_shell(void *cmd);
 
 void init_interface_list();
 
+static void watch_interface_list();
+
+static void watch_instances();
+
+static void watch_config_file();
+
+static void show_running_info();
+
 void* init_running_info(void *);
 
 static gboolean update_progress_in_timeout (gpointer pbar);
@@ -60,7 +68,6 @@ static guint start_pb_pulse();
 
 static void on_create_hp_clicked(GtkWidget *widget,gpointer data);
 
-static void *stopHp(void *);
 
 static int init_config_val_input(ConfigValues* cv);
 
@@ -70,7 +77,20 @@ static void set_error_text(char * text);
 
 gchar* get_accepted_macs();
 
-static void set_connected_devices_label(); // new
+static gchar* client_tooltip(const ClientRow *row);
+static void set_connected_devices_label();
+
+static void init_traffic_view();
+
+static void init_device_view();
+
+static void start_traffic_sampling();
+
+static void stop_traffic_sampling();
+
+static void start_station_events();
+
+static void stop_station_events();
 
 static void on_refresh_clicked(GtkWidget *widget, gpointer data);
 
@@ -32,13 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
-#include <ctype.h>
 #include "util.h"
-#include <regex.h>
-
-regex_t regex;
-int reti;
-char msgbuf[100];
+#include "validator.h"
 
 int find_str(char *find, const char **array, int length) {
     int i;
@@ -55,97 +50,117 @@ int find_str(char *find, const char **array, int length) {
 }
 
 
-void rand_str(char *dest, size_t length) {
-    char charset[] = "0123456789"
-                     "abcdefghijklmnopqrstuvwxyz"
-                     "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+int isValidMacAddress(const char* mac) {
+    unsigned char addr[6];
 
-    while (length-- > 0) {
-        size_t index = (size_t) ((double) rand() / RAND_MAX * (sizeof charset - 1));
-        *dest++ = charset[index];
-    }
-    *dest = '\0';
+    return validator_parse_mac(mac, strlen(mac), addr, NULL) == 0;
 }
 
 
-int isValidMacAddress(const char* mac) {
-    int i = 0;
-    int s = 0;
-
-    while (*mac) {
-        if (isxdigit(*mac)) {
-            i++;
-        }
-        else if (*mac == ':' || *mac == '-') {
+int isValidAcceptedMacs(const char *macs){
+    return validator_mac_list(macs, strlen(macs), NULL, NULL, 0, NULL) > 0 ? 0 : -1;
+}
 
-            if (i == 0 || i / 2 - 1 != s)
-                break;
+int isValidIPaddress(const char * ip){
+    unsigned char addr[4];
 
-            ++s;
-        }
-        else {
-            s = -1;
-        }
+    return validator_parse_ipv4(ip, strlen(ip), addr, NULL) == 0 ? 0 : -1;
+}
 
+/**
+ * Append s to buf, escaping the characters that delimit WIFI: fields if
+ * escape is set.
+ */
+static int qr_append(char *buf, size_t size, size_t *n, const char *s, int escape) {
 
-        ++mac;
+    for (; *s; s++) {
+        if (escape && strchr("\\;,\":", *s) != NULL) {
+            if (*n + 1 >= size)
+                return -1;
+            buf[(*n)++] = '\\';
+        }
+        if (*n + 1 >= size)
+            return -1;
+        buf[(*n)++] = *s;
     }
-
-    return (i == 12 && (s == 5 || s == 0));
+    buf[*n] = '\0';
+    return 0;
 }
 
+int wifi_qr_string(char *buf, size_t size, const char *ssid, const char *type, const char *password) {
 
-int isValidAcceptedMacs(const char *macs){
+    size_t n = 0;
+    int open_network = password == NULL || *password == '\0';
 
-    /* Compile regular expression */
-    reti = regcomp(&regex, "^(((([0-9A-Fa-f]{2}):){5}[0-9A-Fa-f]{2}\\s*)(^((([0-9A-Fa-f]{2}):){5}[0-9A-Fa-f]{2}\\s*))*)$", REG_EXTENDED);
-    if (reti) {
-        //printf( "Could not compile regex\n");
+    if (qr_append(buf, size, &n, "WIFI:S:", 0) < 0
+        || qr_append(buf, size, &n, ssid, 1) < 0
+        || qr_append(buf, size, &n, ";T:", 0) < 0
+        || qr_append(buf, size, &n, open_network ? "nopass" : type, 0) < 0
+        || qr_append(buf, size, &n, ";", 0) < 0)
         return -1;
-    }
 
-    /* Execute regular expression */
-    reti = regexec(&regex, macs, 0, NULL, 0);
-    if (!reti) {
-        return 0;
-    }
-    else if (reti == REG_NOMATCH) {
-        //puts("Invalid mac addresses");
+    if (!open_network
+        && (qr_append(buf, size, &n, "P:", 0) < 0
+            || qr_append(buf, size, &n, password, 1) < 0
+            || qr_append(buf, size, &n, ";", 0) < 0))
         return -1;
-    }
-    else {
-        regerror(reti, &regex, msgbuf, sizeof(msgbuf));
-        //printf("Regex match failed: %s\n", msgbuf);
+
+    if (qr_append(buf, size, &n, ";", 0) < 0)
         return -1;
-    }
 
+    return (int) n;
 }
 
-int isValidIPaddress(const char * ip){
-
+int csv_split(char *line, char **fields, int max) {
+
+    char *r = line, *w = line;
+    int n = 0;
+
+    for (;;) {
+        if (n == max)
+            return -1;
+        fields[n++] = w;
+
+        if (*r == '"') {
+            for (r++;; r++) {
+                if (*r == '\0')
+                    return -1;
+                if (*r == '"') {
+                    if (r[1] != '"')
+                        break;
+                    r++;
+                }
+                *w++ = *r;
+            }
+            r++;
+        }
+        while (*r != ',' && *r != '\0' && *r != '\r' && *r != '\n')
+            *w++ = *r++;
 
-     /* Compile regular expression */
-    reti = regcomp(&regex, 
-        "^(([0-9]|[1-9][0-9]|1[0-9][0-9]|2[0-4][0-9]|25[0-5])\\.){3}([0-9]|[1-9][0-9]|1[0-9][0-9]|2[0-4][0-9]|25[0-5])$",
-        REG_EXTENDED);
-    if (reti) {
-        //printf( "Could not compile regex\n");
-        return -1;
+        if (*r != ',') {
+            *w = '\0';
+            return n;
+        }
+        r++;
+        *w++ = '\0';
     }
+}
 
-    /* Execute regular expression */
-    reti = regexec(&regex, ip, 0, NULL, 0);
-    if (!reti) {
-        return 0;
-    }
-    else if (reti == REG_NOMATCH) {
-        //puts("Invalid ip addresses");
-        return -1;
-    }
-    else {
-        regerror(reti, &regex, msgbuf, sizeof(msgbuf));
-        //printf("Regex match failed: %s\n", msgbuf);
+int proc_stat_starttime(const char *stat, unsigned long long *ticks) {
+
+    const char *p = strrchr(stat, ')');
+    char *end;
+
+    if (p == NULL)
         return -1;
+
+    // starttime is field 22, it follows the 20th space after the name
+    for (int field = 0; field < 20; field++) {
+        p = strchr(p + 1, ' ');
+        if (p == NULL)
+            return -1;
     }
 
-}
\ No newline at end of file
+    *ticks = strtoull(p + 1, &end, 10);
+    return end != p + 1 ? 0 : -1;
+}
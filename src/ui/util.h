@@ -32,9 +32,32 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define WIHOTSPOT_UTIL_H
 
 int find_str(char *find, const char **array, int length);
-void rand_str(char *dest, size_t length);
 int isValidMacAddress(const char*);
 int isValidAcceptedMacs(const char*);
 int isValidIPaddress(const char*);
 
+/**
+ * Write the WIFI: payload of a network QR code to buf. ';', ',', ':', '"'
+ * and '\' in the SSID and password are escaped. An empty password makes
+ * an open network.
+ * Returns the length, or -1 if buf is too small.
+ */
+int wifi_qr_string(char *buf, size_t size, const char *ssid, const char *type, const char *password);
+
+/**
+ * Split one CSV record in place, dropping the line ending. A field may be
+ * quoted with '"', with '""' for a quote inside it.
+ * Returns the number of fields, or -1 if a quote is not closed or there
+ * are more than max fields.
+ */
+int csv_split(char *line, char **fields, int max);
+
+/**
+ * Read the start time of a process, in clock ticks since boot, from the
+ * contents of /proc/<pid>/stat. The command name may hold spaces and
+ * parentheses, so fields are counted from its last ')'.
+ * Returns 0, or -1 if stat is malformed.
+ */
+int proc_stat_starttime(const char *stat, unsigned long long *ticks);
+
 #endif //WIHOTSPOT_UTIL_H
@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#include <string.h>
+
+#include "validator.h"
+
+enum {
+    CC_OTHER = 0,
+    CC_BLANK,
+    CC_SEP,
+};
+
+static const unsigned char CHAR_CLASS[256] = {
+    [' '] = CC_BLANK, ['\t'] = CC_BLANK, ['\r'] = CC_BLANK, ['\v'] = CC_BLANK, ['\f'] = CC_BLANK,
+    [':'] = CC_SEP, ['-'] = CC_SEP,
+};
+
+// digit value + 1, 0 for anything else
+static const unsigned char HEX_VALUE[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+    ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+};
+
+static const unsigned char DEC_VALUE[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+    ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+};
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+int validator_parse_mac(const char *s, size_t len, unsigned char mac[6], size_t *bad){
+
+    const unsigned char *p = (const unsigned char *) s;
+    unsigned char sep = 0;
+    size_t i = 0;
+
+    for (int n = 0; n < 6; n++) {
+        unsigned int hi, lo;
+
+        if (n > 0) {
+            if (i >= len || CHAR_CLASS[p[i]] != CC_SEP || (sep != 0 && p[i] != sep))
+                goto fail;
+            sep = p[i++];
+        }
+        if (i >= len || (hi = HEX_VALUE[p[i]]) == 0)
+            goto fail;
+        i++;
+        if (i >= len || (lo = HEX_VALUE[p[i]]) == 0)
+            goto fail;
+        i++;
+        mac[n] = (unsigned char) ((hi - 1) << 4 | (lo - 1));
+    }
+
+    if (i == len)
+        return 0;
+
+fail:
+    if (bad != NULL)
+        *bad = i;
+    return -1;
+}
+
+int validator_parse_ipv4(const char *s, size_t len, unsigned char ip[4], size_t *bad){
+
+    const unsigned char *p = (const unsigned char *) s;
+    size_t i = 0;
+
+    for (int n = 0; n < 4; n++) {
+        size_t start;
+        unsigned int v = 0;
+
+        if (n > 0) {
+            if (i >= len || p[i] != '.')
+                goto fail;
+            i++;
+        }
+        for (start = i; i < len && DEC_VALUE[p[i]] != 0; i++) {
+            // no leading zeros, no more than 255
+            if (i > start && v == 0)
+                goto fail;
+            v = v * 10 + DEC_VALUE[p[i]] - 1;
+            if (v > 255)
+                goto fail;
+        }
+        if (i == start)
+            goto fail;
+        ip[n] = (unsigned char) v;
+    }
+
+    if (i == len)
+        return 0;
+
+fail:
+    if (bad != NULL)
+        *bad = i;
+    return -1;
+}
+
+static size_t format_mac(char *out, const unsigned char mac[6]){
+
+    for (int n = 0; n < 6; n++) {
+        out[n * 3] = HEX_DIGITS[mac[n] >> 4];
+        out[n * 3 + 1] = HEX_DIGITS[mac[n] & 15];
+        out[n * 3 + 2] = n < 5 ? ':' : '\n';
+    }
+    return MAC_STR_LEN + 1;
+}
+
+long validator_mac_list(const char *text, size_t len, char *out,
+                        ValidatorError *errors, size_t max_errors, size_t *n_errors){
+
+    const unsigned char *p = (const unsigned char *) text;
+    size_t pos = 0, o = 0, nerr = 0;
+    unsigned int line = 1;
+    long count = 0;
+
+    while (pos < len) {
+        const char *nl = memchr(text + pos, '\n', len - pos);
+        size_t end = nl != NULL ? (size_t) (nl - text) : len;
+        size_t first = pos, last = end;
+        unsigned char mac[6];
+        size_t bad;
+
+        while (first < last && CHAR_CLASS[p[first]] == CC_BLANK)
+            first++;
+        while (last > first && CHAR_CLASS[p[last - 1]] == CC_BLANK)
+            last--;
+
+        if (first < last && p[first] != '#') {
+            if (validator_parse_mac(text + first, last - first, mac, &bad) == 0) {
+                if (out != NULL)
+                    o += format_mac(out + o, mac);
+                count++;
+            } else {
+                if (nerr < max_errors) {
+                    errors[nerr].line = line;
+                    errors[nerr].column = (unsigned int) (first + bad - pos + 1);
+                }
+                nerr++;
+            }
+        }
+
+        pos = end + 1;
+        line++;
+    }
+
+    if (out != NULL)
+        out[o] = '\0';
+    if (n_errors != NULL)
+        *n_errors = nerr;
+
+    return nerr > 0 ? -1 : count;
+}
@@ -0,0 +1,83 @@
+/*
+Copyright (c) 2026, lakinduaksh
+        All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+        this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+        IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+        FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+        CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef WIHOTSPOT_VALIDATOR_H
+#define WIHOTSPOT_VALIDATOR_H
+
+#include <stddef.h>
+
+/*
+ * MAC address and IPv4 parsers that replace the POSIX regex based checks.
+ *
+ * Every byte is classified through a 256 entry table built at compile
+ * time, so a check is one pass over the input with no allocation.
+ *
+ * A MAC address is six hex pairs separated by ':' or '-', one separator
+ * kind per address. An IPv4 address is four decimal octets without
+ * leading zeros.
+ *
+ * An accept list has one MAC address per line. Blank lines, surrounding
+ * blanks and lines starting with '#' are allowed, as in hostapd's
+ * accept_mac_file.
+ */
+
+#define MAC_STR_LEN 17  // "aa:bb:cc:dd:ee:ff"
+
+typedef struct {
+    unsigned int line;    // 1-based
+    unsigned int column;  // 1-based, in bytes
+} ValidatorError;
+
+/**
+ * Parse the MAC address in s[0..len) into mac.
+ * Returns 0, or -1 with *bad (if not NULL) set to the offset of the first
+ * offending byte.
+ */
+int validator_parse_mac(const char *s, size_t len, unsigned char mac[6], size_t *bad);
+
+/**
+ * Parse the IPv4 address in s[0..len) into ip, in network order.
+ * Returns 0, or -1 with *bad (if not NULL) set to the offset of the first
+ * offending byte.
+ */
+int validator_parse_ipv4(const char *s, size_t len, unsigned char ip[4], size_t *bad);
+
+/**
+ * Validate an accept list and write it to out in canonical form, one
+ * lower case, ':' separated address per line.
+ *
+ * out may be NULL to only validate, otherwise it must hold len + 2 bytes.
+ * It is NUL terminated and only holds the whole list if there is no error.
+ * The first max_errors errors go to errors; *n_errors (if not NULL) gets
+ * the total count.
+ *
+ * Returns the number of addresses, or -1 if any line is invalid.
+ */
+long validator_mac_list(const char *text, size_t len, char *out,
+                        ValidatorError *errors, size_t max_errors, size_t *n_errors);
+
+#endif //WIHOTSPOT_VALIDATOR_H
@@ -0,0 +1,252 @@
+/*
+ * Benchmarks for the parsing and rendering hot paths.
+ *
+ * Every benchmark prints one JSON object per line:
+ *
+ *   {"name": ..., "iterations": ..., "ns_per_op": ..., "allocs_per_op": ...,
+ *    "bytes_per_op": ..., "peak_rss_kb": ...}
+ *
+ * Allocations are counted by wrapping the libc allocator, so they include
+ * the ones made by libstdc++, libpng and libqrencode. peak_rss_kb is the
+ * peak of the whole process up to the end of that benchmark.
+ *
+ * Run a single benchmark with: bench <name>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <read_config.h>
+#include <lease_tracker.h>
+#include <util.h>
+#include <qrgen.h>
+
+#define MIN_NS 200000000LL
+#define MAX_ITERATIONS 100000000L
+
+#define LEASE_LINES 10000
+#define ACCEPT_MACS 5000
+#define MAC_COUNT 5000
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+static unsigned long alloc_count;
+static unsigned long long alloc_bytes;
+
+void *malloc(size_t size){
+    alloc_count++;
+    alloc_bytes += size;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size){
+    alloc_count++;
+    alloc_bytes += n * size;
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size){
+    alloc_count++;
+    alloc_bytes += size;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr){
+    __libc_free(ptr);
+}
+
+typedef void (*BenchFunc)(void *arg, long i);
+
+static long long now_ns(void){
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static long peak_rss_kb(void){
+
+    struct rusage ru;
+
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+/**
+ * Run fn with doubling iteration counts until a batch takes MIN_NS and
+ * report that batch.
+ */
+static void run_bench(const char *filter, const char *name, BenchFunc fn, void *arg){
+
+    long n = 1;
+    long long elapsed;
+    unsigned long allocs;
+    unsigned long long bytes;
+
+    if (filter != NULL && strcmp(filter, name) != 0)
+        return;
+
+    fn(arg, 0);
+
+    for (;;) {
+        long long start;
+
+        alloc_count = 0;
+        alloc_bytes = 0;
+        start = now_ns();
+        for (long i = 0; i < n; i++)
+            fn(arg, i);
+        elapsed = now_ns() - start;
+        allocs = alloc_count;
+        bytes = alloc_bytes;
+
+        if (elapsed >= MIN_NS || n >= MAX_ITERATIONS)
+            break;
+        n *= 2;
+    }
+
+    printf("{\"name\": \"%s\", \"iterations\": %ld, \"ns_per_op\": %.1f, \"allocs_per_op\": %.2f, "
+           "\"bytes_per_op\": %.1f, \"peak_rss_kb\": %ld}\n",
+           name, n, (double) elapsed / n, (double) allocs / n, (double) bytes / n, peak_rss_kb());
+    fflush(stdout);
+}
+
+static const char LONG_SSID[] = "wihotspot benchmark network 32b";
+static const char LONG_PASS[] = "a rather long passphrase used for the benchmark, 63 chars long!";
+
+static void bench_read_config(void *arg, long i){
+    read_config_file_path(arg);
+}
+
+typedef struct {
+    LeaseTracker *tracker;
+    char *text[2];
+    size_t len[2];
+} LeaseBench;
+
+static void bench_lease_feed(void *arg, long i){
+
+    LeaseBench *b = arg;
+
+    lease_tracker_feed(b->tracker, b->text[i & 1], b->len[i & 1]);
+}
+
+static void bench_mac(void *arg, long i){
+
+    char (*macs)[18] = arg;
+
+    isValidMacAddress(macs[i % MAC_COUNT]);
+}
+
+static void bench_accepted_macs(void *arg, long i){
+    isValidAcceptedMacs(arg);
+}
+
+static const QrRasterOptions A3_600DPI = {160, 5, 600};  // about 29 cm wide at version 4
+
+static void bench_qr(void *arg, long i){
+    qr_to_file(arg, "/tmp/wihotspot-bench-qr.png", NULL);
+}
+
+static void bench_qr_a3(void *arg, long i){
+    qr_to_file(arg, "/tmp/wihotspot-bench-qr.png", &A3_600DPI);
+}
+
+static void bench_qr_pdf(void *arg, long i){
+    qr_to_file(arg, "/tmp/wihotspot-bench-qr.pdf", &A3_600DPI);
+}
+
+static char *write_config(void){
+
+    static char path[] = "/tmp/wihotspot-bench-XXXXXX";
+    ConfigValues cv;
+    char buf[2048];
+    int len, fd;
+
+    memset(&cv, 0, sizeof(cv));
+    cv.iface_wifi = "wlp3s0";
+    cv.iface_inet = "enp0s31f6";
+    cv.ssid = (char *) LONG_SSID;
+    cv.pass = (char *) LONG_PASS;
+    cv.freq = "5";
+    cv.channel = "36";
+    cv.mac_filter = "1";
+    cv.ieee80211ac = "1";
+
+    len = serialize_config_values(&cv, buf, sizeof(buf));
+    fd = mkstemp(path);
+    if (len < 0 || fd < 0 || write(fd, buf, len) != len)
+        return NULL;
+    close(fd);
+    return path;
+}
+
+/**
+ * A lease file of LEASE_LINES leases. variant changes the first line, so
+ * feeding the two variants in turn compares every line and parses one.
+ */
+static char *lease_file(int variant, size_t *len){
+
+    char *text = malloc(LEASE_LINES * 96);
+    size_t n = 0;
+
+    for (int i = 0; i < LEASE_LINES; i++)
+        n += sprintf(text + n, "%d 02:00:00:%02x:%02x:%02x 10.%d.%d.%d host-%d 01:02:00:00:%02x:%02x:%02x\n",
+                     1700000000 + i + (i == 0 ? variant : 0), i >> 16, (i >> 8) & 255, i & 255,
+                     i >> 16, (i >> 8) & 255, i & 255, i, i >> 16, (i >> 8) & 255, i & 255);
+    *len = n;
+    return text;
+}
+
+int main(int argc, char *argv[]){
+
+    const char *filter = argc > 1 ? argv[1] : NULL;
+    char *config = write_config();
+    LeaseBench leases;
+    static char macs[MAC_COUNT][18];
+    char *accept;
+    char qr[256];
+    size_t n = 0;
+
+    if (config == NULL) {
+        perror("Could not write the benchmark config");
+        return 1;
+    }
+    run_bench(filter, "read_config_file", bench_read_config, config);
+    unlink(config);
+
+    leases.tracker = lease_tracker_new(NULL);
+    leases.text[0] = lease_file(0, &leases.len[0]);
+    leases.text[1] = lease_file(1, &leases.len[1]);
+    run_bench(filter, "lease_tracker_feed_10k", bench_lease_feed, &leases);
+    lease_tracker_free(leases.tracker);
+    free(leases.text[0]);
+    free(leases.text[1]);
+
+    for (int i = 0; i < MAC_COUNT; i++)
+        snprintf(macs[i], sizeof(macs[i]), i % 2 ? "02:00:00:00:%02x:%02x" : "02-00-00-00-%02x-%02x", i >> 8, i & 255);
+    run_bench(filter, "isValidMacAddress", bench_mac, macs);
+
+    accept = malloc(ACCEPT_MACS * 18 + 1);
+    for (int i = 0; i < ACCEPT_MACS; i++)
+        n += sprintf(accept + n, "02:00:00:00:%02x:%02x\n", i >> 8, i & 255);
+    run_bench(filter, "isValidAcceptedMacs_5k", bench_accepted_macs, accept);
+    free(accept);
+
+    snprintf(qr, sizeof(qr), "WIFI:T:WPA;S:%s;P:%s;;", LONG_SSID, LONG_PASS);
+    run_bench(filter, "qr_to_png", bench_qr, qr);
+    run_bench(filter, "qr_to_png_a3_600dpi", bench_qr_a3, qr);
+    unlink("/tmp/wihotspot-bench-qr.png");
+    run_bench(filter, "qr_to_pdf", bench_qr_pdf, qr);
+    unlink("/tmp/wihotspot-bench-qr.pdf");
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <client_table.h>
+
+static void make_station(StationInfo *st, int n, uint32_t tx_packets){
+
+    memset(st, 0, sizeof(StationInfo));
+    st->mac[0] = 0x02;
+    st->mac[4] = (unsigned char) (n >> 8);
+    st->mac[5] = (unsigned char) n;
+    st->tx_packets = tx_packets;
+}
+
+int main(int argc, char *argv[]){
+
+    ClientTable *t = client_table_new();
+    StationInfo st;
+    char buf[32];
+    int i;
+
+    assert(t != NULL);
+
+    // Many rows force the MAC index to grow
+    client_table_begin(t);
+    for (i = 0; i < 500; i++) {
+        make_station(&st, i, 10);
+        assert(client_table_update(t, &st) >= 0);
+        assert(client_table_set_lease(t, st.mac, htonl(0xc0a80c0a), i % 2 ? "phone" : "*") >= 0);
+    }
+    assert(500 == client_table_end(t));
+    assert(500 == client_table_count(t));
+
+    make_station(&st, 7, 0);
+    i = client_table_find(t, st.mac);
+    assert(i >= 0);
+    assert(0 == strcmp("phone", client_table_hostname(t, client_table_row(t, i))));
+    client_format_ipv4(client_table_row(t, i)->ipv4, buf);
+    assert(0 == strcmp("192.168.12.10", buf));
+    client_format_mac(client_table_row(t, i)->mac, buf);
+    assert(0 == strcmp("02:00:00:00:00:07", buf));
+
+    // Same values again: nothing changes
+    client_table_begin(t);
+    for (i = 0; i < 500; i++) {
+        make_station(&st, i, 10);
+        client_table_update(t, &st);
+        client_table_set_lease(t, st.mac, htonl(0xc0a80c0a), i % 2 ? "phone" : "*");
+    }
+    assert(0 == client_table_end(t));
+
+    // Drop every third station and change one counter
+    client_table_begin(t);
+    for (i = 0; i < 500; i++) {
+        if (i % 3 == 0)
+            continue;
+        make_station(&st, i, i == 1 ? 11 : 10);
+        client_table_update(t, &st);
+    }
+    assert(167 == client_table_end(t));
+    assert(333 == client_table_count(t));
+    assert(167 == client_table_removed_count(t));
+
+    for (i = 0; i < 500; i++) {
+        make_station(&st, i, 0);
+        assert((client_table_find(t, st.mac) >= 0) == (i % 3 != 0));
+    }
+
+    // Counters are updated in place, only the lease marks a row changed
+    make_station(&st, 1, 0);
+    i = client_table_find(t, st.mac);
+    assert(CLIENT_UNCHANGED == client_table_row(t, i)->state);
+    assert(11 == client_table_row(t, i)->tx_packets);
+    assert(i == client_table_set_lease(t, st.mac, 0, "laptop"));
+    assert(CLIENT_CHANGED == client_table_row(t, i)->state);
+    assert(0 == strcmp("laptop", client_table_hostname(t, client_table_row(t, i))));
+
+    make_station(&st, 0, 0);
+    assert(-1 == client_table_set_lease(t, st.mac, 0, "gone"));
+
+    // A station that left between refreshes
+    make_station(&st, 2, 0);
+    assert(0 == client_table_remove(t, st.mac));
+    assert(-1 == client_table_find(t, st.mac));
+    assert(-1 == client_table_remove(t, st.mac));
+    assert(332 == client_table_count(t));
+    for (i = 0; i < 500; i++) {
+        make_station(&st, i, 0);
+        assert((client_table_find(t, st.mac) >= 0) == (i % 3 != 0 && i != 2));
+    }
+
+    // and one that joined
+    make_station(&st, 0, 5);
+    i = client_table_update(t, &st);
+    assert(i >= 0);
+    assert(CLIENT_ADDED == client_table_row(t, i)->state);
+    assert(5 == client_table_row(t, i)->tx_packets);
+    assert(333 == client_table_count(t));
+
+    client_table_begin(t);
+    assert(CLIENT_UNCHANGED == client_table_row(t, client_table_update(t, &st))->state);
+    assert(332 == client_table_end(t));
+    assert(1 == client_table_count(t));
+
+    client_table_free(t);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <hostapd_ctrl.h>
+
+static const unsigned char MAC[6] = {0x02, 0x11, 0x22, 0x33, 0x44, 0xaa};
+
+static int parse(const char *msg, HostapdEvent *ev){
+    return hostapd_event_parse(msg, strlen(msg), ev);
+}
+
+/**
+ * Answer ATTACH like hostapd, then push two events and a reply to some
+ * other command, which the client has to ignore.
+ */
+static void fake_hostapd(int server){
+
+    struct sockaddr_un peer;
+    socklen_t peer_len = sizeof(peer);
+    char buf[64];
+    ssize_t n;
+
+    n = recvfrom(server, buf, sizeof(buf), 0, (struct sockaddr *) &peer, &peer_len);
+    if (n != 6 || memcmp(buf, "ATTACH", 6) != 0)
+        _exit(1);
+
+    sendto(server, "OK\n", 3, 0, (struct sockaddr *) &peer, peer_len);
+    sendto(server, "<3>AP-STA-CONNECTED 02:11:22:33:44:aa", 37, 0, (struct sockaddr *) &peer, peer_len);
+    sendto(server, "PONG\n", 5, 0, (struct sockaddr *) &peer, peer_len);
+    sendto(server, "<3>AP-STA-DISCONNECTED 02:11:22:33:44:aa", 40, 0, (struct sockaddr *) &peer, peer_len);
+
+    n = recv(server, buf, sizeof(buf), 0);
+    _exit(n == 6 && memcmp(buf, "DETACH", 6) == 0 ? 0 : 1);
+}
+
+int main(int argc, char *argv[]){
+
+    HostapdEvent ev;
+
+    assert(0 == parse("<3>AP-STA-CONNECTED 02:11:22:33:44:aa", &ev));
+    assert(HOSTAPD_EVENT_STA_CONNECTED == ev.type && 0 == memcmp(ev.mac, MAC, 6));
+    assert(0 == parse("<3>AP-STA-DISCONNECTED 02:11:22:33:44:AA\n", &ev));
+    assert(HOSTAPD_EVENT_STA_DISCONNECTED == ev.type && 0 == memcmp(ev.mac, MAC, 6));
+    assert(0 == parse("<3>IFNAME=ap0 EAPOL-4WAY-HS-COMPLETED 02:11:22:33:44:aa", &ev));
+    assert(HOSTAPD_EVENT_HANDSHAKE_DONE == ev.type);
+    assert(0 == parse("<3>AP-STA-CONNECTED 02:11:22:33:44:aa keyid=guest", &ev));
+    assert(-1 == parse("<3>AP-STA-CONNECTED 02:11:22:33:44", &ev));
+    assert(-1 == parse("<3>AP-STA-CONNECTED 02:11:22:33:44:aab", &ev));
+    assert(-1 == parse("<3>AP-STA-CONNECTEDX 02:11:22:33:44:aa", &ev));
+    assert(-1 == parse("<3>CTRL-EVENT-EAP-STARTED 02:11:22:33:44:aa", &ev));
+    assert(-1 == parse("AP-STA-CONNECTED 02:11:22:33:44:aa", &ev));
+    assert(-1 == parse("OK\n", &ev));
+
+    char confdir[] = "/tmp/test_hostapd_ctrl.XXXXXX";
+    char dir[128];
+    struct sockaddr_un sa = {.sun_family = AF_UNIX};
+    HostapdEvent events[4];
+    HostapdCtrl *c;
+    int server, status, count = 0;
+    pid_t pid;
+
+    assert(NULL != mkdtemp(confdir));
+    snprintf(dir, sizeof(dir), "%s/hostapd_ctrl", confdir);
+    assert(0 == mkdir(dir, 0700));
+
+    assert(NULL == hostapd_ctrl_open(confdir, "wlan0"));
+
+    snprintf(sa.sun_path, sizeof(sa.sun_path), "%s/wlan0", dir);
+    server = socket(AF_UNIX, SOCK_DGRAM, 0);
+    assert(server >= 0);
+    assert(0 == bind(server, (struct sockaddr *) &sa, sizeof(sa)));
+
+    pid = fork();
+    assert(pid >= 0);
+    if (pid == 0)
+        fake_hostapd(server);
+
+    c = hostapd_ctrl_open(confdir, "wlan0");
+    assert(c != NULL);
+
+    while (count < 2) {
+        struct pollfd pfd = {hostapd_ctrl_fd(c), POLLIN, 0};
+        int n;
+
+        assert(1 == poll(&pfd, 1, 1000));
+        n = hostapd_ctrl_dispatch(c, events + count, 4 - count);
+        assert(n >= 0);
+        count += n;
+    }
+    assert(2 == count);
+    assert(HOSTAPD_EVENT_STA_CONNECTED == events[0].type && 0 == memcmp(events[0].mac, MAC, 6));
+    assert(HOSTAPD_EVENT_STA_DISCONNECTED == events[1].type);
+    assert(0 == hostapd_ctrl_dispatch(c, events, 4));
+
+    hostapd_ctrl_close(c);
+    assert(pid == waitpid(pid, &status, 0));
+    assert(WIFEXITED(status) && 0 == WEXITSTATUS(status));
+
+    close(server);
+    unlink(sa.sun_path);
+    rmdir(dir);
+    rmdir(confdir);
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <lease_tracker.h>
+
+static const unsigned char MAC_A[6] = {0xaa, 0xbb, 0xcc, 0x00, 0x00, 0x01};
+static const unsigned char MAC_B[6] = {0xaa, 0xbb, 0xcc, 0x00, 0x00, 0x02};
+static const unsigned char MAC_C[6] = {0xaa, 0xbb, 0xcc, 0x00, 0x00, 0x03};
+
+int main(int argc, char *argv[]){
+
+    LeaseTracker *t = lease_tracker_new(NULL);
+    const LeaseInfo *l;
+    char buf[8192];
+    size_t len;
+    int i;
+
+    const char *v1 =
+        "1700000000 aa:bb:cc:00:00:01 192.168.12.10 phone 01:aa:bb:cc:00:00:01\n"
+        "1700000100 aa:bb:cc:00:00:02 192.168.12.11 * 01:aa:bb:cc:00:00:02\n";
+
+    assert(t != NULL);
+    assert(1 == lease_tracker_feed(t, v1, strlen(v1)));
+    assert(0 == lease_tracker_feed(t, v1, strlen(v1)));
+    assert(2 == lease_tracker_count(t));
+
+    l = lease_tracker_lookup(t, MAC_A);
+    assert(l != NULL);
+    assert(1700000000 == l->expiry);
+    assert(htonl(0xc0a80c0a) == l->ipv4);
+    assert(0 == strcmp("phone", l->hostname));
+    assert(0 == strcmp("*", lease_tracker_lookup(t, MAC_B)->hostname));
+    assert(NULL == lease_tracker_lookup(t, MAC_C));
+
+    // Renewed second lease, new third one, duid and IPv6 lines ignored
+    const char *v2 =
+        "1700000000 aa:bb:cc:00:00:01 192.168.12.10 phone 01:aa:bb:cc:00:00:01\n"
+        "1700000500 aa:bb:cc:00:00:02 192.168.12.11 laptop 01:aa:bb:cc:00:00:02\n"
+        "1700000600 aa:bb:cc:00:00:03 192.168.12.12 tv *\n"
+        "duid 00:01:00:01:2c:6f:aa:bb:cc:dd:ee:ff\n"
+        "1700000700 1234 fd00::2 host 00:01\n";
+
+    assert(1 == lease_tracker_feed(t, v2, strlen(v2)));
+    assert(3 == lease_tracker_count(t));
+    assert(1700000500 == lease_tracker_lookup(t, MAC_B)->expiry);
+    assert(0 == strcmp("laptop", lease_tracker_lookup(t, MAC_B)->hostname));
+    assert(0 == strcmp("tv", lease_tracker_lookup(t, MAC_C)->hostname));
+
+    // Expired lease dropped from the middle
+    const char *v3 =
+        "1700000000 aa:bb:cc:00:00:01 192.168.12.10 phone 01:aa:bb:cc:00:00:01\n"
+        "1700000600 aa:bb:cc:00:00:03 192.168.12.12 tv *\n";
+
+    assert(1 == lease_tracker_feed(t, v3, strlen(v3)));
+    assert(2 == lease_tracker_count(t));
+    assert(NULL == lease_tracker_lookup(t, MAC_B));
+    assert(lease_tracker_lookup(t, MAC_A) != NULL);
+
+    // dnsmasq puts a new lease first, the others only move
+    const char *v4 =
+        "1700000900 aa:bb:cc:00:00:02 192.168.12.13 tablet *\n"
+        "1700000000 aa:bb:cc:00:00:01 192.168.12.10 phone 01:aa:bb:cc:00:00:01\n"
+        "1700000600 aa:bb:cc:00:00:03 192.168.12.12 tv *\n";
+
+    assert(1 == lease_tracker_feed(t, v4, strlen(v4)));
+    assert(3 == lease_tracker_count(t));
+    assert(0 == strcmp("tablet", lease_tracker_lookup(t, MAC_B)->hostname));
+    assert(1700000600 == lease_tracker_lookup(t, MAC_C)->expiry);
+
+    // Same leases in another order
+    const char *v5 =
+        "1700000600 aa:bb:cc:00:00:03 192.168.12.12 tv *\n"
+        "1700000900 aa:bb:cc:00:00:02 192.168.12.13 tablet *\n"
+        "1700000000 aa:bb:cc:00:00:01 192.168.12.10 phone 01:aa:bb:cc:00:00:01\n";
+
+    assert(0 == lease_tracker_feed(t, v5, strlen(v5)));
+    assert(3 == lease_tracker_count(t));
+
+    // A later line for the same MAC wins
+    const char *v6 =
+        "1700000600 aa:bb:cc:00:00:03 192.168.12.12 tv *\n"
+        "1700001000 aa:bb:cc:00:00:03 192.168.12.14 tv2 *\n";
+
+    assert(1 == lease_tracker_feed(t, v6, strlen(v6)));
+    assert(1 == lease_tracker_count(t));
+    assert(0 == strcmp("tv2", lease_tracker_lookup(t, MAC_C)->hostname));
+    assert(1 == lease_tracker_feed(t, v5, strlen(v5)));
+    assert(0 == strcmp("tv", lease_tracker_lookup(t, MAC_C)->hostname));
+    assert(1 == lease_tracker_feed(t, v6, strlen(v6)));
+    assert(0 == strcmp("tv2", lease_tracker_lookup(t, MAC_C)->hostname));
+
+    // Enough leases to grow the index
+    len = 0;
+    for (i = 0; i < 100; i++)
+        len += snprintf(buf + len, sizeof(buf) - len, "%d 02:00:00:00:00:%02x 10.0.0.%d h%d *\n",
+                        1700000000 + i, i, i + 1, i);
+
+    assert(1 == lease_tracker_feed(t, buf, len));
+    assert(100 == lease_tracker_count(t));
+    assert(NULL == lease_tracker_lookup(t, MAC_A));
+
+    assert(1 == lease_tracker_feed(t, "", 0));
+    assert(0 == lease_tracker_count(t));
+
+    lease_tracker_free(t);
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <qr_raster.h>
+
+#define WIDTH 21
+
+// The old writePNG() loop, one pixel at a time
+static void reference_row(const unsigned char *modules, int width, const QrRasterOptions *o, unsigned char *row){
+
+    memset(row, 0xff, qr_raster_stride(width, o));
+    for (int x = 0; x < width; x++) {
+        for (int xx = 0; xx < o->scale; xx++) {
+            size_t bit = (size_t) (o->margin + x) * o->scale + xx;
+
+            row[bit / 8] ^= (modules[x] & 1) << (7 - bit % 8);
+        }
+    }
+}
+
+static char *render(int (*write)(FILE *, const unsigned char *, int, const QrRasterOptions *),
+                    const unsigned char *data, int width, const QrRasterOptions *o, size_t *len){
+
+    char *text;
+    FILE *fp = open_memstream(&text, len);
+
+    assert(0 == write(fp, data, width, o));
+    fclose(fp);
+    return text;
+}
+
+// Check the cross reference table, the stream lengths and the page count
+static void check_pdf(const char *text, int pages){
+
+    const char *p = strstr(text, "\nxref\n0 ") + 1, *q;
+    int n = atoi(p + 7);
+
+    assert(0 == strncmp(text, "%PDF-1.4\n", 9));
+    assert(atol(strstr(text, "startxref\n") + 10) == p - text);
+    p = strchr(p + 5, '\n') + 1 + 20;
+    for (int i = 1; i < n; i++, p += 20) {
+        char obj[24];
+
+        snprintf(obj, sizeof(obj), "%d 0 obj\n", i);
+        assert(0 == strncmp(text + atol(p), obj, strlen(obj)));
+    }
+
+    for (q = text; (q = strstr(q, "/Length ")) != NULL; q++) {
+        const char *stream = strstr(q, "stream\n") + 7;
+
+        assert(atol(q + 8) == strstr(stream, "endstream") - stream);
+    }
+
+    q = strstr(text, "/Type /Pages /Count ");
+    assert(q != NULL && atoi(q + 20) == pages);
+}
+
+int main(int argc, char *argv[]){
+
+    unsigned char data[WIDTH * WIDTH], row[512], expected[512];
+    char *text;
+    size_t len;
+
+    srand(1);
+    for (int i = 0; i < WIDTH * WIDTH; i++)
+        data[i] = 0xc0 | (rand() & 1);
+    // runs that start and end on byte boundaries and span several bytes
+    memset(data, 1, WIDTH);
+
+    for (int scale = 1; scale <= 17; scale++) {
+        for (int margin = 0; margin <= 5; margin++) {
+            QrRasterOptions o = {scale, margin, 300};
+
+            assert((WIDTH + 2 * margin) * scale == qr_raster_side(WIDTH, &o));
+            for (int y = 0; y < WIDTH; y++) {
+                reference_row(data + y * WIDTH, WIDTH, &o, expected);
+                qr_raster_row(data + y * WIDTH, WIDTH, &o, row);
+                assert(0 == memcmp(row, expected, qr_raster_stride(WIDTH, &o)));
+            }
+            qr_raster_row(NULL, WIDTH, &o, row);
+            for (size_t i = 0; i < qr_raster_stride(WIDTH, &o); i++)
+                assert(0xff == row[i]);
+        }
+    }
+
+    assert(QR_FORMAT_SVG == qr_format_from_path("wifi.svg"));
+    assert(QR_FORMAT_PDF == qr_format_from_path("/tmp/a.b/WIFI.PDF"));
+    assert(QR_FORMAT_PNG == qr_format_from_path("wifi.png"));
+    assert(QR_FORMAT_PNG == qr_format_from_path("-"));
+
+    unsigned char small[4] = {1, 1,
+                              0, 1};
+    QrRasterOptions print = {10, 1, 254};  // 1 mm per module
+
+    text = render(qr_write_svg, small, 2, &print, &len);
+    assert(strlen(text) == len);
+    assert(NULL != strstr(text, "width=\"4.0000mm\" height=\"4.0000mm\" viewBox=\"0 0 4 4\""));
+    assert(NULL != strstr(text, "d=\"M1 1h2v1h-2z\nM2 2h1v1h-1z\n\""));
+    free(text);
+
+    text = render(qr_write_pdf, small, 2, &print, &len);
+    check_pdf(text, 1);
+    assert(NULL != strstr(text, "/MediaBox [0 0 11.3384 11.3384]"));
+    assert(NULL != strstr(text, "q 2.8346 0 0 -2.8346 0 11.3384 cm\n1 1 2 1 re\n2 2 1 1 re\nf Q\n"));
+    free(text);
+
+    // a streamed PDF with captions
+    const char *caption[2] = {"Wi-Fi: caf\xc3\xa9 (2)", "Password: \xe2\x82\xac\\"};
+    QrPdfPage page;
+    FILE *fp = open_memstream(&text, &len);
+    QrPdf *pdf = qr_pdf_new(fp);
+
+    assert(0 == qr_pdf_page_render(&page, small, 2, &print, caption, 2));
+    assert(page.width == 113384 && page.height > page.width);
+    for (int i = 0; i < 40; i++)
+        assert(0 == qr_pdf_add_page(pdf, &page));
+    qr_pdf_page_clear(&page);
+    assert(0 == qr_pdf_finish(pdf));
+    fclose(fp);
+    check_pdf(text, 40);
+    assert(NULL != strstr(text, "(Wi-Fi: caf\\351 \\(2\\)) Tj"));
+    assert(NULL != strstr(text, "(Password: ?\\\\) Tj"));
+    free(text);
+
+    return 0;
+}
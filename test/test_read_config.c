@@ -0,0 +1,148 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <read_config.h>
+
+static int count_lines(const char *s){
+
+    int n = 0;
+
+    for (; *s; s++)
+        n += *s == '\n';
+    return n;
+}
+
+static void write_file(const char *path, const char *text){
+
+    FILE *fp = fopen(path, "w");
+
+    assert(fp != NULL);
+    fputs(text, fp);
+    fclose(fp);
+}
+
+int main(int argc, char *argv[]){
+
+    ConfigValues cv, loaded;
+    char path[] = "/tmp/test_read_config-XXXXXX";
+    char buf[2048];
+    char again[2048];
+    char big[512];
+    int len;
+
+    close(mkstemp(path));
+
+    memset(&cv, 0, sizeof(cv));
+    cv.iface_wifi = "wlan0";
+    cv.iface_inet = "eth0";
+    cv.ssid = "my net";
+    cv.pass = "pass word=1";
+    cv.freq = "5";
+    cv.hidden = "1";
+    cv.use_psk = "0";
+
+    len = serialize_config_values(&cv, buf, sizeof(buf));
+    assert(len > 0);
+    assert((size_t) len == strlen(buf));
+
+    // Every create_ap config option, one per line
+    assert(36 == count_lines(buf));
+    assert(0 == strncmp("CHANNEL=default\n", buf, 16));
+    assert(strstr(buf, "\nGATEWAY=192.168.12.1\n") != NULL);
+    assert(strstr(buf, "\nSSID=my net\n") != NULL);
+    assert(strstr(buf, "\nPASSPHRASE=pass word=1\n") != NULL);
+    assert(strstr(buf, "\nFREQ_BAND=5\n") != NULL);
+    assert(strstr(buf, "\nHIDDEN=1\n") != NULL);
+    assert(strstr(buf, "\nUSE_PSK=0\n") != NULL);
+    assert(strstr(buf, "\nMAC_FILTER=0\n") != NULL);
+    assert(strstr(buf, "\nMAC_FILTER_ACCEPT=/etc/hostapd/hostapd.accept\n") != NULL);
+    assert(strstr(buf, "\nNEW_MACADDR=\n") != NULL);
+    assert(strstr(buf, "\nWIFI_IFACE=wlan0\n") != NULL);
+    assert(strstr(buf, "\nINTERNET_IFACE=eth0\n") != NULL);
+    assert(strstr(buf, "\nROTATE_PASSPHRASE=never\n") != NULL);
+    assert(strstr(buf, "\nTRAFFIC_SAMPLE_MS=1000\n") != NULL);
+
+    cv.freq = NULL;
+    cv.channel = "11";
+    cv.accepted_mac_file = "/etc/hostapd/accept";
+    assert(serialize_config_values(&cv, buf, sizeof(buf)) > 0);
+    assert(0 == strncmp("CHANNEL=11\n", buf, 11));
+    assert(strstr(buf, "\nFREQ_BAND=default\n") != NULL);
+    assert(strstr(buf, "\nMAC_FILTER_ACCEPT=/etc/hostapd/accept\n") != NULL);
+
+    // A line break would inject another option
+    cv.ssid = "evil\nGATEWAY=1.2.3.4";
+    assert(-1 == serialize_config_values(&cv, buf, sizeof(buf)));
+    cv.ssid = "my net";
+
+    assert(-1 == serialize_config_values(&cv, buf, 64));
+
+    // Every key written comes back, including the ones the GUI does not edit
+    cv.country = "DE";
+    cv.share_method = "bridge";
+    cv.ht_capab = "[HT40-][SHORT-GI-40]";
+    cv.dhcp_hosts = "/etc/hosts.dhcp";
+    cv.rotate_passphrase = "daily";
+    cv.traffic_sample_ms = "500";
+    len = serialize_config_values(&cv, buf, sizeof(buf));
+    assert(len > 0);
+    write_file(path, buf);
+    assert(READ_CONFIG_FILE_SUCCESS == config_values_load(path, &loaded));
+    assert(0 == strcmp("my net", loaded.ssid));
+    assert(0 == strcmp("pass word=1", loaded.pass));
+    assert(0 == strcmp("11", loaded.channel));
+    assert(0 == strcmp("default", loaded.freq));
+    assert(0 == strcmp("1", loaded.hidden));
+    assert(0 == strcmp("/etc/hostapd/accept", loaded.accepted_mac_file));
+    assert(0 == strcmp("DE", loaded.country));
+    assert(0 == strcmp("bridge", loaded.share_method));
+    assert(0 == strcmp("[HT40-][SHORT-GI-40]", loaded.ht_capab));
+    assert(0 == strcmp("/etc/hosts.dhcp", loaded.dhcp_hosts));
+    assert(0 == strcmp("daily", loaded.rotate_passphrase));
+    assert(0 == strcmp("500", loaded.traffic_sample_ms));
+    assert(0 == strcmp("", loaded.mac));
+    assert(len == serialize_config_values(&loaded, again, sizeof(again)));
+    assert(0 == strcmp(buf, again));
+    config_values_free(&loaded);
+
+    // Comments, blank lines, unknown keys, CRLF, padding and a last line
+    // without a newline. Missing keys get create_ap's defaults.
+    write_file(path, "# profile\n"
+                     "\n"
+                     "  CHANNEL = 6 \r\n"
+                     "UNKNOWN=1\n"
+                     "SSID= spaced ssid \r\n"
+                     "no equals sign\n"
+                     "CHANNEL=7\n"
+                     "PASSPHRASE=12345678");
+    assert(READ_CONFIG_FILE_SUCCESS == config_values_load(path, &loaded));
+    assert(0 == strcmp("7", loaded.channel));
+    assert(0 == strcmp(" spaced ssid ", loaded.ssid));
+    assert(0 == strcmp("12345678", loaded.pass));
+    assert(0 == strcmp("192.168.12.1", loaded.gateway));
+    assert(0 == strcmp("2", loaded.wpa_version));
+    assert(0 == strcmp("nat", loaded.share_method));
+    assert(0 == strcmp("0", loaded.hidden));
+    assert(NULL == loaded.accepted_macs);
+    config_values_free(&loaded);
+
+    // Values are not limited in length
+    memset(big, 'a', sizeof(big));
+    memcpy(big, "DHCP_HOSTS=", 11);
+    big[sizeof(big) - 1] = '\0';
+    write_file(path, big);
+    assert(READ_CONFIG_FILE_SUCCESS == config_values_load(path, &loaded));
+    assert(sizeof(big) - 12 == strlen(loaded.dhcp_hosts));
+    config_values_free(&loaded);
+
+    write_file(path, "");
+    assert(READ_CONFIG_FILE_SUCCESS == read_config_file_path(path));
+    assert(0 == strcmp("default", getConfigValues()->channel));
+
+    unlink(path);
+    assert(READ_CONFIG_FILE_FAIL == config_values_load(path, &loaded));
+
+    return 0;
+}
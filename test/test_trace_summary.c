@@ -0,0 +1,62 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <trace_summary.h>
+
+// As written by create_ap --trace, nested phases come before their parent
+static const char TRACE[] =
+    "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+    "{\"name\":\"adapter probing\",\"cat\":\"start\",\"ph\":\"X\",\"ts\":1000,\"dur\":200000,\"pid\":42,\"tid\":0},"
+    "{\"name\":\"uplink channel\",\"cat\":\"start\",\"ph\":\"X\",\"ts\":300000,\"dur\":100000,\"pid\":42,\"tid\":0},"
+    "{\"name\":\"NetworkManager\",\"cat\":\"start\",\"ph\":\"X\",\"ts\":500000,\"dur\":250000,\"pid\":42,\"tid\":0},"
+    "{\"name\":\"virtual interface\",\"cat\":\"start\",\"ph\":\"X\",\"ts\":250000,\"dur\":600000,\"pid\":42,\"tid\":0},"
+    "{\"name\":\"cleanup phase\",\"cat\":\"cleanup\",\"ph\":\"X\",\"ts\":9000000,\"dur\":5000,\"pid\":42,\"tid\":0},"
+    "{\"name\":\"hostapd\",\"cat\":\"start\",\"ph\":\"X\",\"ts\":900000,\"dur\":1100000,\"pid\":42,\"tid\":0}"
+    "]}\n";
+
+static int parse(const char *json, const char *cat, TraceSummary *s){
+
+    return trace_summary_parse(json, strlen(json), cat, s);
+}
+
+int main(int argc, char *argv[]){
+
+    TraceSummary s;
+    char buf[256];
+
+    assert(3 == parse(TRACE, "start", &s));
+    assert(0 == strcmp(s.phases[0].name, "adapter probing"));
+    assert(0 == strcmp(s.phases[1].name, "virtual interface"));
+    assert(0 == strcmp(s.phases[2].name, "hostapd"));
+    assert(s.phases[1].ts == 250000 && s.phases[1].dur == 600000);
+    assert(s.total == 2000000);
+
+    assert(0 < trace_summary_format(&s, buf, sizeof(buf)));
+    assert(0 == strcmp(buf, "adapter probing: 0.20 s\nvirtual interface: 0.60 s\nhostapd: 1.10 s\nother: 0.10 s"));
+    assert(-1 == trace_summary_format(&s, buf, 20));
+
+    assert(1 == parse(TRACE, "cleanup", &s));
+    assert(0 == strcmp(s.phases[0].name, "cleanup phase"));
+    assert(4 == parse(TRACE, NULL, &s));
+
+    // a bare array, other event types, extra fields and escapes
+    assert(2 == parse("[{\"name\":\"a\\\"b\",\"ph\":\"X\",\"ts\":2.6,\"dur\":1e3,\"args\":{\"x\":[1,true,null]}},"
+                      "{\"name\":\"mark\",\"ph\":\"i\",\"ts\":5},"
+                      "{\"name\":\"later\",\"ph\":\"X\",\"ts\":2000,\"dur\":10}, {}]", NULL, &s));
+    assert(0 == strcmp(s.phases[0].name, "a\"b"));
+    assert(s.phases[0].ts == 3 && s.phases[0].dur == 1000);
+
+    // a phase identical to another one is counted once
+    assert(1 == parse("[{\"name\":\"in\",\"ph\":\"X\",\"ts\":0,\"dur\":10},{\"name\":\"out\",\"ph\":\"X\",\"ts\":0,\"dur\":10}]", NULL, &s));
+    assert(0 == strcmp(s.phases[0].name, "out"));
+
+    assert(0 == parse("{\"traceEvents\":[]}", NULL, &s));
+    assert(0 == trace_summary_format(&s, buf, sizeof(buf)) && buf[0] == '\0');
+
+    assert(-1 == parse("", NULL, &s));
+    assert(-1 == parse("{\"displayTimeUnit\":\"ms\"}", NULL, &s));
+    assert(-1 == parse("{\"traceEvents\":[{\"name\":\"a\",\"ph\":\"X\",\"ts\":1", NULL, &s));
+    assert(-1 == parse("[{\"name\":\"a\",\"ts\":x}]", NULL, &s));
+
+    return 0;
+}
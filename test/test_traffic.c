@@ -0,0 +1,101 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <traffic.h>
+
+static const unsigned char MAC_A[6] = {0xaa, 0xbb, 0xcc, 0x00, 0x00, 0x01};
+static const unsigned char MAC_B[6] = {0xaa, 0xbb, 0xcc, 0x00, 0x00, 0x02};
+static const unsigned char MAC_C[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x03};
+
+int main(int argc, char *argv[]){
+
+    TrafficHistory h;
+    TrafficMonitor *m;
+    float rx, tx;
+    int i;
+
+    assert(1000 == traffic_sample_interval(NULL));
+    assert(1000 == traffic_sample_interval(""));
+    assert(250 == traffic_sample_interval("250"));
+    assert(1000 == traffic_sample_interval("50"));
+    assert(1000 == traffic_sample_interval("2s"));
+    assert(1000 == traffic_sample_interval("99999999999999999999"));
+
+    traffic_history_reset(&h);
+
+    // The first sample only sets the baseline
+    assert(0 == traffic_history_push(&h, 1000, 5000, 0));
+    assert(0 == traffic_history_len(&h));
+
+    assert(1 == traffic_history_push(&h, 3000, 6000, 2000000));
+    assert(1 == traffic_history_len(&h));
+    traffic_history_get(&h, 0, &rx, &tx);
+    assert(1000 == rx);
+    assert(500 == tx);
+
+    // Same timestamp is ignored, a counter reset restarts the history
+    assert(0 == traffic_history_push(&h, 9000, 9000, 2000000));
+    assert(1 == traffic_history_len(&h));
+    assert(0 == traffic_history_push(&h, 10, 10, 3000000));
+    assert(0 == traffic_history_len(&h));
+    assert(1 == traffic_history_push(&h, 110, 10, 4000000));
+    traffic_history_get(&h, 0, &rx, &tx);
+    assert(100 == rx);
+    assert(0 == tx);
+
+    // The ring keeps the latest TRAFFIC_HISTORY rates, oldest first
+    traffic_history_reset(&h);
+    traffic_history_push(&h, 0, 0, 0);
+    for (i = 1; i <= TRAFFIC_HISTORY + 10; i++)
+        traffic_history_push(&h, (unsigned long long) i * (i + 1) / 2, 0, i * 1000000LL);
+    assert(TRAFFIC_HISTORY == traffic_history_len(&h));
+    traffic_history_get(&h, 0, &rx, &tx);
+    assert(11 == rx);
+    traffic_history_get(&h, TRAFFIC_HISTORY - 1, &rx, &tx);
+    assert(TRAFFIC_HISTORY + 10 == rx);
+    assert(TRAFFIC_HISTORY + 10 == traffic_history_peak(&h));
+
+    m = traffic_monitor_new();
+    assert(m != NULL);
+
+    traffic_monitor_begin(m);
+    assert(0 == traffic_monitor_sample_client(m, MAC_B, 0, 0, 0));
+    assert(0 == traffic_monitor_sample_client(m, MAC_A, 0, 0, 0));
+    assert(0 == traffic_monitor_sample_client(m, MAC_C, 0, 0, 0));
+    traffic_monitor_end(m);
+
+    traffic_monitor_begin(m);
+    traffic_monitor_sample_client(m, MAC_A, 4000, 2000, 1000000);
+    traffic_monitor_sample_client(m, MAC_C, 100, 100, 1000000);
+    traffic_monitor_end(m);
+
+    // B was not sampled again and is dropped, A kept its history
+    assert(NULL == traffic_monitor_client(m, MAC_B));
+    assert(1 == traffic_history_len(traffic_monitor_client(m, MAC_A)));
+    traffic_history_get(traffic_monitor_client(m, MAC_A), 0, &rx, &tx);
+    assert(4000 == rx);
+    assert(2000 == tx);
+    assert(traffic_monitor_client(m, MAC_C) != NULL);
+
+    // Enough clients to grow the table
+    traffic_monitor_begin(m);
+    for (i = 0; i < 100; i++) {
+        unsigned char mac[6] = {0x02, 0, 0, 0, (unsigned char) (i * 37 % 256), (unsigned char) i};
+        assert(0 == traffic_monitor_sample_client(m, mac, i, i, 2000000));
+    }
+    traffic_monitor_end(m);
+    for (i = 0; i < 100; i++) {
+        unsigned char mac[6] = {0x02, 0, 0, 0, (unsigned char) (i * 37 % 256), (unsigned char) i};
+        assert(traffic_monitor_client(m, mac) != NULL);
+    }
+    assert(NULL == traffic_monitor_client(m, MAC_A));
+
+    // Interfaces that do not exist are not sampled
+    assert(-1 == traffic_monitor_sample_iface(m, TRAFFIC_IFACE_AP, "nonexistent0", 0));
+    assert(0 == traffic_history_len(traffic_monitor_iface(m, TRAFFIC_IFACE_AP)));
+    assert(0 == traffic_monitor_sample_iface(m, TRAFFIC_IFACE_UPLINK, "lo", 0));
+    assert(0 == strcmp("lo", traffic_monitor_iface_name(m, TRAFFIC_IFACE_UPLINK)));
+
+    traffic_monitor_free(m);
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include <util.h>
 
 int main(int argc, char *argv[]){
@@ -10,5 +11,48 @@ int main(int argc, char *argv[]){
     assert(-1 == isValidIPaddress("255.255.255.2551"));
     assert(-1 == isValidIPaddress("192.168.12"));
 
+    assert(1 == isValidMacAddress("aa:bb:cc:dd:ee:ff"));
+    assert(0 == isValidMacAddress("aa:bb:cc:dd:ee"));
+    assert(0 == isValidAcceptedMacs("aa:bb:cc:dd:ee:ff\nAA-BB-CC-DD-EE-00\n"));
+    assert(-1 == isValidAcceptedMacs("aa:bb:cc:dd:ee:ff\nnot a mac\n"));
+    assert(-1 == isValidAcceptedMacs(""));
+
+    char qr[64];
+
+    assert(30 == wifi_qr_string(qr, sizeof(qr), "home", "WPA", "secret12"));
+    assert(0 == strcmp(qr, "WIFI:S:home;T:WPA;P:secret12;;"));
+    assert(0 < wifi_qr_string(qr, sizeof(qr), "a;b,c", "WPA", "p:a\"s\\s"));
+    assert(0 == strcmp(qr, "WIFI:S:a\\;b\\,c;T:WPA;P:p\\:a\\\"s\\\\s;;"));
+    assert(0 < wifi_qr_string(qr, sizeof(qr), "cafe", "WPA", ""));
+    assert(0 == strcmp(qr, "WIFI:S:cafe;T:nopass;;"));
+    assert(-1 == wifi_qr_string(qr, 30, "home", "WPA", "secret12"));
+    assert(30 == wifi_qr_string(qr, 31, "home", "WPA", "secret12"));
+
+    char line[64], *fields[3];
+
+    strcpy(line, "guest-01,pass word\r\n");
+    assert(2 == csv_split(line, fields, 3));
+    assert(0 == strcmp(fields[0], "guest-01") && 0 == strcmp(fields[1], "pass word"));
+    strcpy(line, "\"a,\"\"b\"\"\",,x");
+    assert(3 == csv_split(line, fields, 3));
+    assert(0 == strcmp(fields[0], "a,\"b\"") && 0 == strcmp(fields[1], "") && 0 == strcmp(fields[2], "x"));
+    strcpy(line, "");
+    assert(1 == csv_split(line, fields, 3));
+    assert(0 == strcmp(fields[0], ""));
+    strcpy(line, "\"open");
+    assert(-1 == csv_split(line, fields, 3));
+    strcpy(line, "a,b,c,d");
+    assert(-1 == csv_split(line, fields, 3));
+
+    unsigned long long ticks;
+
+    assert(0 == proc_stat_starttime("1234 (create_ap) S 1 1234 1234 0 -1 4194560 2190 90212 0 2 3 5 "
+                                    "120 80 20 0 1 0 51234 9003008 950 18446744073709551615", &ticks));
+    assert(51234 == ticks);
+    assert(0 == proc_stat_starttime("7 (a) b) (c) S 1 7 7 0 -1 0 0 0 0 0 0 0 0 0 20 0 1 0 99 0 0", &ticks));
+    assert(99 == ticks);
+    assert(-1 == proc_stat_starttime("7 (a) S 1 7 7", &ticks));
+    assert(-1 == proc_stat_starttime("no command name", &ticks));
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <validator.h>
+
+#define S(s) s, sizeof(s) - 1
+
+int main(int argc, char *argv[]){
+
+    unsigned char mac[6], ip[4];
+    ValidatorError errors[4];
+    char out[256];
+    size_t bad, n;
+
+    assert(0 == validator_parse_mac(S("aa:BB:cc:00:11:ff"), mac, &bad));
+    assert(0xaa == mac[0] && 0xbb == mac[1] && 0xff == mac[5]);
+    assert(0 == validator_parse_mac(S("aa-bb-cc-00-11-22"), mac, NULL));
+
+    // One separator kind per address, exactly six pairs
+    assert(-1 == validator_parse_mac(S("aa:bb-cc:00:11:22"), mac, &bad));
+    assert(5 == bad);
+    assert(-1 == validator_parse_mac(S("aabbcc001122"), mac, &bad));
+    assert(2 == bad);
+    assert(-1 == validator_parse_mac(S("aa:bb:cc:00:11"), mac, &bad));
+    assert(14 == bad);
+    assert(-1 == validator_parse_mac(S("aa:bb:cc:00:11:22:"), mac, &bad));
+    assert(17 == bad);
+    assert(-1 == validator_parse_mac(S("aa:bb:cg:00:11:22"), mac, &bad));
+    assert(7 == bad);
+
+    assert(0 == validator_parse_ipv4(S("192.168.12.1"), ip, NULL));
+    assert(192 == ip[0] && 168 == ip[1] && 12 == ip[2] && 1 == ip[3]);
+    assert(0 == validator_parse_ipv4(S("0.0.0.0"), ip, NULL));
+    assert(0 == validator_parse_ipv4(S("255.255.255.255"), ip, NULL));
+    assert(-1 == validator_parse_ipv4(S("255.255.255.256"), ip, &bad));
+    assert(14 == bad);
+    assert(-1 == validator_parse_ipv4(S("192.168.012.1"), ip, &bad));
+    assert(9 == bad);
+    assert(-1 == validator_parse_ipv4(S("192.168.12"), ip, &bad));
+    assert(10 == bad);
+    assert(-1 == validator_parse_ipv4(S("192.168.12.1 "), ip, &bad));
+    assert(12 == bad);
+    assert(-1 == validator_parse_ipv4(S("1..2.3"), ip, &bad));
+    assert(2 == bad);
+
+    // Comments, blank lines, CRLF and surrounding blanks are accepted
+    assert(3 == validator_mac_list(S("# phones\r\nAA:BB:CC:00:11:22\r\n\n  aa-bb-cc-00-11-23\t\n02:00:00:00:00:01"),
+                                   out, errors, 4, &n));
+    assert(0 == n);
+    assert(0 == strcmp(out, "aa:bb:cc:00:11:22\naa:bb:cc:00:11:23\n02:00:00:00:00:01\n"));
+
+    // Every bad line is reported with the column of the offending byte
+    assert(-1 == validator_mac_list(S("aa:bb:cc:00:11:22\n  aa:bb:cc:00:11\nxx\naa:bb:cc:00:11:22 1\nzz\nzz\n"),
+                                    NULL, errors, 3, &n));
+    assert(5 == n);
+    assert(2 == errors[0].line && 17 == errors[0].column);
+    assert(3 == errors[1].line && 1 == errors[1].column);
+    assert(4 == errors[2].line && 18 == errors[2].column);
+
+    assert(0 == validator_mac_list(S(""), out, NULL, 0, &n));
+    assert(0 == n && '\0' == out[0]);
+    assert(0 == validator_mac_list(S("\n# none\n"), NULL, NULL, 0, NULL));
+
+    return 0;
+}